@@ -0,0 +1,544 @@
+#include "include/Batch.hpp"
+#include "include/Graph.hpp"
+#include "include/Instrument.hpp"
+#include "include/Reporter.hpp"
+#include "include/SolutionFile.hpp"
+#include "include/ThreadPool.hpp"
+#include "include/Validator.hpp"
+#include "include/defines.hpp"
+
+#include <filesystem>
+
+using namespace std;
+
+namespace {
+
+struct BatchOptions {
+    vector<string>   algorithms = { "guloso", "adaptativo", "reativo" };
+    vector<float>    alphas = { 0.5f };
+    bool             alphas_given = false;
+    vector<uint64_t> seeds = { 1 };
+    size_t           iterations = 100;
+    size_t           moves = TabuConfig().max_iter;
+    size_t           elite = GraspConfig().elite_size;
+    size_t           threads = 1;
+    size_t           jobs = 1;
+    double           time_limit = 0;
+    float            target_gap = -1;
+    uint64_t         node_limit = 0;
+    string           checkpoint_dir;
+    string           solutions_dir;
+    string           initial;
+    double           checkpoint_interval = 60;
+    bool             resume = false;
+    bool             progress = false;
+    string           format = "csv";
+    string           output;
+    string           instrumentation; // resumo da instrumentação, uma linha JSON por execução
+    string           trace_dir;
+    vector<string>   inputs;
+};
+
+void mostra_uso(const char* program) {
+    cerr << "Uso: " << program << " [opções] <instância|diretório>...\n"
+         << "  --algoritmo a,b,...  guloso, adaptativo, reativo, exato e/ou tabu (padrão: os três primeiros)\n"
+         << "  --alpha x,y,...      alphas do adaptativo, entre 0 e 1; no reativo, o conjunto de alphas\n"
+         << "  --iteracoes n        iterações do reativo (padrão: 100; 0 = até --tempo ou --alvo)\n"
+         << "  --movimentos n       movimentos da busca tabu (padrão: 10000; 0 = até --tempo ou --alvo)\n"
+         << "  --semente s,t,...    sementes (padrão: 1)\n"
+         << "  --elite n            tamanho do pool de elite do reativo para o path-relinking (padrão: 10; 0 = sem)\n"
+         << "  --threads n          threads do reativo e do exato (padrão: 1)\n"
+         << "  --trabalhos n        execuções simultâneas, cada uma com --threads (padrão: 1)\n"
+         << "  --tempo segundos     limite de tempo do reativo, do exato e da busca tabu (padrão: sem limite)\n"
+         << "  --nos n              limite de nós da árvore do exato (padrão: sem limite)\n"
+         << "  --alvo gap           o reativo e a busca tabu param ao atingir esse gap (padrão: sem alvo)\n"
+         << "  --progresso          escreve em stderr cada melhora do reativo e da busca tabu, com o instante\n"
+         << "  --checkpoint dir     grava o estado de cada execução do reativo em dir/<instância>.s<semente>.ckpt\n"
+         << "  --intervalo-checkpoint segundos  tempo mínimo entre checkpoints (padrão: 60)\n"
+         << "  --retoma             continua cada execução do reativo do seu checkpoint, se existir\n"
+         << "  --solucoes dir       grava a partição de cada execução em dir/<instância>.<algoritmo>.s<semente>.sol\n"
+         << "  --inicial arquivo    a busca tabu parte da solução do arquivo em vez do guloso\n"
+         << "  --formato csv|json   formato das linhas de resultado (padrão: csv)\n"
+         << "  --saida arquivo      grava os resultados no arquivo em vez da saída padrão\n"
+         << "  --instrumentacao arquivo  contadores e tempos por fase de cada execução, em JSON (make INSTRUMENT=1)\n"
+         << "  --trace dir          trace de cada execução em dir/<instância>.<algoritmo>.s<semente>.trace.json,\n"
+         << "                       para chrome://tracing ou Perfetto (make INSTRUMENT=1)\n";
+}
+
+vector<string> separa(const string& list) {
+    vector<string> items;
+    stringstream stream(list);
+    string item;
+    while (getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+bool le_opcoes(int argc, char* argv[], BatchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.compare(0, 2, "--") != 0) {
+            options.inputs.push_back(arg);
+            continue;
+        }
+        if (arg == "--progresso") {
+            options.progress = true;
+            continue;
+        }
+        if (arg == "--retoma") {
+            options.resume = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Opção sem valor: " << arg << "\n";
+            return false;
+        }
+        string value = argv[++i];
+        bool valid = true;
+        if (arg == "--algoritmo") {
+            options.algorithms = separa(value);
+        } else if (arg == "--alpha") {
+            options.alphas.clear();
+            for (const string& item : separa(value)) {
+                float alpha = 0;
+                valid = valid && le_numero(item, alpha) && alpha >= 0 && alpha <= 1;
+                options.alphas.push_back(alpha);
+            }
+            options.alphas_given = true;
+        } else if (arg == "--semente") {
+            options.seeds.clear();
+            for (const string& item : separa(value)) {
+                uint64_t seed = 0;
+                valid = valid && le_numero(item, seed);
+                options.seeds.push_back(seed);
+            }
+        } else if (arg == "--iteracoes") {
+            valid = le_numero(value, options.iterations);
+        } else if (arg == "--movimentos") {
+            valid = le_numero(value, options.moves);
+        } else if (arg == "--elite") {
+            valid = le_numero(value, options.elite);
+        } else if (arg == "--threads") {
+            valid = le_numero(value, options.threads);
+            options.threads = max<size_t>(1, options.threads);
+        } else if (arg == "--trabalhos") {
+            valid = le_numero(value, options.jobs);
+            options.jobs = max<size_t>(1, options.jobs);
+        } else if (arg == "--tempo") {
+            valid = le_numero(value, options.time_limit) && options.time_limit >= 0;
+        } else if (arg == "--alvo") {
+            valid = le_numero(value, options.target_gap);
+        } else if (arg == "--nos") {
+            valid = le_numero(value, options.node_limit);
+        } else if (arg == "--solucoes") {
+            options.solutions_dir = value;
+        } else if (arg == "--inicial") {
+            options.initial = value;
+        } else if (arg == "--checkpoint") {
+            options.checkpoint_dir = value;
+        } else if (arg == "--intervalo-checkpoint") {
+            valid = le_numero(value, options.checkpoint_interval) && options.checkpoint_interval >= 0;
+        } else if (arg == "--formato") {
+            options.format = value;
+        } else if (arg == "--saida") {
+            options.output = value;
+        } else if (arg == "--instrumentacao") {
+            options.instrumentation = value;
+        } else if (arg == "--trace") {
+            options.trace_dir = value;
+        } else {
+            cerr << "Opção desconhecida: " << arg << "\n";
+            return false;
+        }
+        if (!valid) {
+            cerr << "Valor inválido para " << arg << ": " << value << "\n";
+            return false;
+        }
+    }
+    for (const string& algorithm : options.algorithms) {
+        if (algorithm != "guloso" && algorithm != "adaptativo" && algorithm != "reativo" && algorithm != "exato" &&
+            algorithm != "tabu") {
+            cerr << "Algoritmo desconhecido: " << algorithm << "\n";
+            return false;
+        }
+    }
+    if (options.format != "csv" && options.format != "json") {
+        cerr << "Formato desconhecido: " << options.format << "\n";
+        return false;
+    }
+    if (options.resume && options.checkpoint_dir.empty()) {
+        cerr << "--retoma precisa de --checkpoint\n";
+        return false;
+    }
+    if (!INSTRUMENTACAO && (!options.instrumentation.empty() || !options.trace_dir.empty())) {
+        cerr << "--instrumentacao e --trace precisam de um binário compilado com make INSTRUMENT=1\n";
+        return false;
+    }
+    return !options.inputs.empty() && !options.seeds.empty() && !options.alphas.empty();
+}
+
+struct RunRow {
+    string   instance;
+    string   algorithm;
+    string   alpha;
+    uint64_t seed;
+    size_t   threads;
+    size_t   iterations;
+    size_t   executed;
+    float    gap;
+    double   load_time;
+    double   time;
+    double   time_to_best;
+    float    bound;
+    bool     valid;   // a solução passou por valida_solucao
+};
+
+void escreve_linha(ostream& out, const string& format, const RunRow& row) {
+    if (format == "csv") {
+        out << row.instance << ',' << row.algorithm << ',' << row.alpha << ',' << row.seed << ','
+            << row.threads << ',' << row.iterations << ',' << row.executed << ',' << row.gap << ','
+            << row.load_time << ',' << row.time << ',' << row.time_to_best << ',' << row.bound << ','
+            << gap_restante_pct(row.gap, row.bound) << ',' << row.valid << '\n';
+    } else {
+        out << "{\"instancia\":\"" << row.instance << "\",\"algoritmo\":\"" << row.algorithm
+            << "\",\"alpha\":\"" << row.alpha << "\",\"semente\":" << row.seed
+            << ",\"threads\":" << row.threads << ",\"iteracoes\":" << row.iterations
+            << ",\"iteracoes_executadas\":" << row.executed << ",\"gap\":" << row.gap
+            << ",\"tempo_carga_s\":" << row.load_time << ",\"tempo_s\":" << row.time
+            << ",\"tempo_ate_melhor_s\":" << row.time_to_best << ",\"limite_inferior\":" << row.bound
+            << ",\"gap_restante_pct\":" << gap_restante_pct(row.gap, row.bound)
+            << ",\"valida\":" << (row.valid ? "true" : "false") << "}\n";
+    }
+    out.flush();
+}
+
+string junta(const vector<float>& values) {
+    stringstream stream;
+    for (size_t i = 0; i < values.size(); ++i) {
+        stream << (i ? ";" : "") << values[i];
+    }
+    return stream.str();
+}
+
+// Instância do lote: carregada pelo primeiro trabalho que precisar dela e
+// liberada quando o último termina, então só as instâncias em uso ficam na memória
+struct BatchInstance {
+    string            path;
+    unique_ptr<Graph> graph; // nullptr se o arquivo não abriu
+    double            load_time = 0;
+    once_flag         loaded;
+    atomic<size_t>    remaining{ 0 }; // trabalhos ainda não terminados
+};
+
+// Uma execução: algoritmo, alpha e semente sobre uma instância
+struct BatchJob {
+    size_t   instance;
+    string   algorithm;
+    float    alpha;
+    uint64_t seed;
+    double   cost; // estimativa do tempo, só para ordenar
+};
+
+// Tamanho do arquivo vezes as iterações: basta para pôr os trabalhos grandes na frente
+double custo_estimado(const string& path, const string& algorithm, const BatchOptions& options) {
+    error_code error;
+    double size = (double)filesystem::file_size(path, error);
+    if (error) {
+        size = 0;
+    }
+    if (algorithm == "tabu") {
+        return size * max<size_t>(options.moves / 100, 1);
+    }
+    const bool iterative = algorithm == "reativo" || algorithm == "exato";
+    return size * (iterative ? max<size_t>(options.iterations, 1) : 1);
+}
+
+// Nome dos arquivos de uma execução: <instância>.<algoritmo>[.a<alpha>].s<semente>
+string nome_execucao(const string& path, const string& algorithm, const string& alpha, uint64_t seed) {
+    string name = filesystem::path(path).stem().string() + "." + algorithm;
+    if (algorithm == "adaptativo") {
+        name += ".a" + alpha;
+    }
+    return name + ".s" + to_string(seed);
+}
+
+// Um checkpoint por execução do reativo: instância e semente a identificam no lote
+string arquivo_checkpoint(const string& dir, const string& path, uint64_t seed) {
+    return (filesystem::path(dir) / filesystem::path(path).stem()).string() + ".s" + to_string(seed) + ".ckpt";
+}
+
+void carrega(BatchInstance& instance, mutex& log_mutex) {
+    if (!ifstream(instance.path)) {
+        lock_guard<mutex> lock(log_mutex);
+        cerr << "Erro ao abrir o arquivo de entrada: " << instance.path << "\n";
+        return;
+    }
+    auto load_start = chrono::steady_clock::now();
+    instance.graph = make_unique<Graph>(instance.path);
+    instance.graph->prepara(instance.graph->_num_clusters);
+    instance.load_time = chrono::duration<double>(chrono::steady_clock::now() - load_start).count();
+}
+
+// Roda um trabalho; o grafo já está preparado e é só lido. As melhoras do
+// reativo (--progresso) vão para log, que o chamador escreve em stderr.
+bool executa_trabalho(const BatchOptions& options, BatchInstance& instance, const BatchJob& job, RunRow& row, ostream& log) {
+    Graph& graph = *instance.graph;
+    const size_t p = graph._num_clusters;
+    const string& algorithm = job.algorithm;
+    row = RunRow{ instance.path, algorithm, "", job.seed, 1, 1, 1, 0.0f, instance.load_time, 0.0, 0.0, -1.0f, false };
+    Solution solution;
+    auto start = chrono::steady_clock::now();
+    if (algorithm == "guloso") {
+        solution = graph.guloso(p, true, job.seed);
+    } else if (algorithm == "adaptativo") {
+        row.alpha = junta({ job.alpha });
+        solution = graph.guloso_randomizado_adaptativo(p, job.alpha, true, job.seed);
+    } else if (algorithm == "exato") {
+        // Incumbente inicial pelo reativo com --iteracoes; iteracoes_executadas traz os nós da árvore
+        ExactConfig config;
+        config.threads = options.threads;
+        config.seed = job.seed;
+        config.time_limit = options.time_limit;
+        config.node_limit = options.node_limit;
+        config.heuristic_iterations = options.iterations;
+        ExactStats stats;
+        row.threads = options.threads;
+        row.iterations = options.iterations;
+        solution = graph.exato(p, config, &stats);
+        row.executed = stats.nos;
+    } else if (algorithm == "tabu") {
+        // iteracoes_executadas traz os movimentos feitos
+        TabuConfig config;
+        config.max_iter = options.moves;
+        config.seed = job.seed;
+        config.time_limit = options.time_limit;
+        config.target_gap = options.target_gap;
+        Reporter progress(graph.csr(), options.progress ? Verbosity::PROGRESS : Verbosity::SILENT, log);
+        if (options.progress) {
+            log << "# " << instance.path << " semente " << job.seed << "\n";
+            config.on_incumbent = progress.incumbent_observer();
+        }
+        Solution initial;
+        if (!options.initial.empty()) {
+            initial = le_solucao(graph.csr(), options.initial);
+            if (!initial.ok()) {
+                log << "Erro em " << instance.path << " (" << algorithm << "): " << initial.erro << "\n";
+                return false;
+            }
+        }
+        TabuStats stats;
+        row.iterations = options.moves;
+        solution = graph.busca_tabu(p, config, &stats, options.initial.empty() ? nullptr : &initial);
+        row.executed = stats.iterations;
+        progress.flush();
+    } else {
+        GraspConfig config;
+        config.threads = options.threads;
+        config.seed = job.seed;
+        config.time_limit = options.time_limit;
+        config.target_gap = options.target_gap;
+        config.elite_size = options.elite;
+        if (options.alphas_given) {
+            config.alphas = options.alphas;
+        }
+        if (!options.checkpoint_dir.empty()) {
+            config.checkpoint = arquivo_checkpoint(options.checkpoint_dir, instance.path, job.seed);
+            config.checkpoint_interval = options.checkpoint_interval;
+            config.resume = options.resume;
+        }
+        Reporter progress(graph.csr(), options.progress ? Verbosity::PROGRESS : Verbosity::SILENT, log);
+        if (options.progress) {
+            log << "# " << instance.path << " semente " << job.seed << "\n";
+            config.on_incumbent = progress.incumbent_observer();
+        }
+        AlphaStats stats;
+        row.alpha = junta(config.alphas);
+        row.threads = options.threads;
+        row.iterations = options.iterations;
+        solution = graph.guloso_randomizado_adaptativo_reativo(p, options.iterations, config, &stats);
+        row.executed = stats.iterations;
+        progress.flush();
+    }
+    // Numa execução retomada, o tempo conta também o que rodou antes do checkpoint,
+    // como o limite de tempo e os instantes das melhorias
+    row.time = chrono::duration<double>(chrono::steady_clock::now() - start).count() + solution.tempo_anterior;
+    row.gap = solution.total_gap;
+    row.bound = solution.limite_inferior;
+    row.time_to_best = solution.melhorias.empty() ? row.time : solution.melhorias.back().segundos;
+    if (!solution.ok()) {
+        log << "Erro em " << instance.path << " (" << algorithm << "): " << solution.erro << "\n";
+        return false;
+    }
+    // O(n + m), barato perto de qualquer heurística: fica sempre ligado
+    INSTRUMENT_PHASE_BEGIN(validation, "validacao");
+    const string problem = valida_solucao(graph.csr(), solution, p);
+    INSTRUMENT_PHASE_END(validation);
+    row.valid = problem.empty();
+    if (!row.valid) {
+        log << "Solução inválida em " << instance.path << " (" << algorithm << "): " << problem << "\n";
+    }
+    if (!options.solutions_dir.empty()) {
+        const string name = nome_execucao(instance.path, algorithm, row.alpha, job.seed) + ".sol";
+        if (!escreve_solucao(graph.csr(), solution, (filesystem::path(options.solutions_dir) / name).string())) {
+            return false;
+        }
+    }
+    return row.valid;
+}
+
+} // namespace
+
+// Arquivos passados diretamente mais os .txt/.bin de cada diretório, em ordem alfabética
+vector<string> lista_instancias(const vector<string>& inputs) {
+    vector<string> files;
+    for (const string& input : inputs) {
+        error_code error;
+        if (filesystem::is_directory(input, error)) {
+            vector<string> found;
+            for (const auto& entry : filesystem::directory_iterator(input, error)) {
+                string extension = entry.path().extension().string();
+                if (entry.is_regular_file() && (extension == ".txt" || extension == ".bin")) {
+                    found.push_back(entry.path().string());
+                }
+            }
+            sort(found.begin(), found.end());
+            files.insert(files.end(), found.begin(), found.end());
+        } else {
+            files.push_back(input);
+        }
+    }
+    return files;
+}
+
+int executa_lote(int argc, char* argv[]) {
+    BatchOptions options;
+    if (!le_opcoes(argc, argv, options)) {
+        mostra_uso(argv[0]);
+        return 1;
+    }
+
+    ofstream file;
+    if (!options.output.empty()) {
+        file.open(options.output);
+        if (!file) {
+            cerr << "Erro ao criar o arquivo de saída: " << options.output << "\n";
+            return 1;
+        }
+    }
+    ostream out(options.output.empty() ? cout.rdbuf() : file.rdbuf());
+    out << setprecision(9);
+    ofstream instrumentation;
+    if (!options.instrumentation.empty()) {
+        instrumentation.open(options.instrumentation);
+        if (!instrumentation) {
+            cerr << "Erro ao criar o arquivo de instrumentação: " << options.instrumentation << "\n";
+            return 1;
+        }
+        instrumentation << setprecision(9);
+    }
+    if (options.format == "csv") {
+        out << "instancia,algoritmo,alpha,semente,threads,iteracoes,iteracoes_executadas,gap,tempo_carga_s,tempo_s,tempo_ate_melhor_s,limite_inferior,gap_restante_pct,valida\n";
+    }
+
+    if (!options.checkpoint_dir.empty()) {
+        error_code error;
+        filesystem::create_directories(options.checkpoint_dir, error);
+        if (error) {
+            cerr << "Erro ao criar o diretório de checkpoints: " << options.checkpoint_dir << "\n";
+            return 1;
+        }
+    }
+    if (!options.solutions_dir.empty()) {
+        error_code error;
+        filesystem::create_directories(options.solutions_dir, error);
+        if (error) {
+            cerr << "Erro ao criar o diretório de soluções: " << options.solutions_dir << "\n";
+            return 1;
+        }
+    }
+    if (!options.trace_dir.empty()) {
+        error_code error;
+        filesystem::create_directories(options.trace_dir, error);
+        if (error) {
+            cerr << "Erro ao criar o diretório de traces: " << options.trace_dir << "\n";
+            return 1;
+        }
+    }
+
+    const vector<string> paths = lista_instancias(options.inputs);
+    vector<BatchInstance> instances(paths.size());
+    vector<BatchJob> jobs;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        instances[i].path = paths[i];
+        for (const string& algorithm : options.algorithms) {
+            // O guloso não usa alpha e o reativo usa a lista inteira como conjunto de alphas
+            vector<float> alphas = algorithm == "adaptativo" ? options.alphas : vector<float>{ 0.0f };
+            const double cost = custo_estimado(paths[i], algorithm, options);
+            for (float alpha : alphas) {
+                for (uint64_t seed : options.seeds) {
+                    jobs.push_back(BatchJob{ i, algorithm, alpha, seed, cost });
+                    instances[i].remaining++;
+                }
+            }
+        }
+    }
+
+    // Com vários trabalhos simultâneos, os maiores começam primeiro para que
+    // nenhum trabalho longo fique para o fim (a ordem entre iguais se mantém).
+    // Com um só, a ordem é a da lista de instâncias.
+    ThreadPool pool(options.jobs);
+    if (pool.size() > 1) {
+        stable_sort(jobs.begin(), jobs.end(), [](const BatchJob& a, const BatchJob& b) { return a.cost > b.cost; });
+    }
+
+    // Cada worker pega o próximo trabalho da lista; as linhas saem na ordem em que terminam
+    mutex out_mutex;
+    atomic<size_t> next(0);
+    atomic<int> status(0);
+    pool.run([&](size_t) {
+        for (size_t j = next++; j < jobs.size(); j = next++) {
+            const BatchJob& job = jobs[j];
+            BatchInstance& instance = instances[job.instance];
+            call_once(instance.loaded, carrega, ref(instance), ref(out_mutex));
+            if (!instance.graph) {
+                status = 1;
+                continue;
+            }
+
+            // Com make INSTRUMENT=1, esta thread e as que a execução usar contam para session
+            RunRow row;
+            ostringstream log;
+            SessaoInstrumentada session(!options.trace_dir.empty());
+            EscopoInstrumentado scope(&session);
+            if (!executa_trabalho(options, instance, job, row, log)) {
+                status = 1;
+            }
+            scope.encerra();
+            {
+                lock_guard<mutex> lock(out_mutex);
+                cerr << log.str();
+                escreve_linha(out, options.format, row);
+                if (instrumentation.is_open()) {
+                    instrumentation << "{\"instancia\":\"" << row.instance << "\",\"algoritmo\":\"" << row.algorithm
+                                    << "\",\"alpha\":\"" << row.alpha << "\",\"semente\":" << row.seed
+                                    << ",\"tempo_s\":" << row.time << ',';
+                    session.escreve_resumo(instrumentation, row.time);
+                    instrumentation << "}\n" << flush;
+                }
+            }
+            if (!options.trace_dir.empty()) {
+                const string name = nome_execucao(instance.path, job.algorithm, row.alpha, job.seed) + ".trace.json";
+                if (!session.escreve_trace((filesystem::path(options.trace_dir) / name).string())) {
+                    status = 1;
+                }
+            }
+            if (--instance.remaining == 0) {
+                instance.graph.reset();
+            }
+        }
+    });
+    return status;
+}
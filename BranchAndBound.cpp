@@ -0,0 +1,470 @@
+#include "include/BranchAndBound.hpp"
+#include "include/Instrument.hpp"
+#include "include/ThreadPool.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+namespace {
+
+const uint32_t NONE = numeric_limits<uint32_t>::max();
+const double   INF = numeric_limits<double>::infinity();
+const uint64_t NODE_BATCH = 256; // nós entre consultas ao relógio e ao contador global
+
+// Subárvore: cluster de cada vértice da ordem até a profundidade do nó
+struct Task {
+    vector<uint32_t> prefix;
+    double           bound;
+};
+
+// Fila de subárvores de um worker: o dono tira do fim, os outros roubam do início
+struct TaskQueue {
+    mutex       lock;
+    deque<Task> tasks;
+    atomic<size_t> size{0};
+};
+
+// Estado compartilhado de uma chamada de run()
+struct SharedSearch {
+    vector<unique_ptr<TaskQueue>> queues;
+    atomic<size_t>   pending{0}; // subárvores criadas e ainda não terminadas
+    atomic<size_t>   idle{0};    // workers procurando trabalho
+    atomic<bool>     stop{false};
+    atomic<uint64_t> nodes{0};
+    atomic<uint64_t> steals{0};
+    uint64_t         node_limit = 0;
+    double           time_limit = 0;
+    Clock::time_point start;
+};
+
+// Uma subárvore com esse limite ainda pode ter algo estritamente melhor que o incumbente
+bool promissor(double bound, double incumbent) {
+    if (incumbent == INF) return bound < INF;
+    return bound < incumbent - 1e-6 * max(1.0, incumbent);
+}
+
+// Opção de ramificação: cluster que recebe o vértice (== k abre um novo)
+struct Option {
+    uint32_t cluster;
+    double   bound;
+};
+
+} // namespace
+
+struct SearchWorker
+{
+    SharedSearch*            shared;
+    size_t                   id;
+    vector<uint32_t>         label;     // cluster de cada vértice ou NONE
+    vector<vector<uint32_t>> members;
+    vector<double>           first;     // peso de quem abriu o cluster (o menor)
+    vector<double>           last;      // maior peso do cluster até aqui
+    size_t                   depth = 0; // vértices da ordem já atribuídos
+    size_t                   opened = 0;
+    size_t                   singles = 0; // clusters com um vértice só
+    double                   cost = 0;
+    vector<double>           saved_last; // desfazer por profundidade
+    vector<double>           saved_cost;
+    vector<vector<Option>>   options;    // buffers por profundidade
+    double                   open_bound = INF; // menor limite de subárvore abandonada na parada
+    uint64_t                 local_nodes = 0;
+
+    // Buffers da verificação de conectividade
+    vector<uint32_t> component;
+    vector<uint32_t> component_size;
+    vector<char>     component_touched;
+    vector<uint32_t> queue;
+    vector<uint32_t> parent;    // união-busca: vértices e, depois de n, componentes livres
+    vector<uint32_t> stamp;
+    uint32_t         generation = 0;
+
+    SearchWorker(SharedSearch* shared, size_t id, size_t n, size_t p)
+        : shared(shared), id(id), label(n, NONE), members(p), first(p, 0), last(p, 0),
+          saved_last(n, 0), saved_cost(n, 0), options(n), component(n, NONE), queue(n),
+          parent(2 * n), stamp(2 * n, 0) {
+        component_size.reserve(n);
+        component_touched.reserve(n);
+    }
+
+    uint32_t find(uint32_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    void unite(uint32_t a, uint32_t b) {
+        a = find(a);
+        b = find(b);
+        if (a != b) parent[a] = b;
+    }
+
+    void assign(const vector<uint32_t>& order, const vector<double>& weight, uint32_t c) {
+        const uint32_t v = order[depth];
+        saved_cost[depth] = cost;
+        if (c == opened) {
+            opened++;
+            singles++;
+            first[c] = last[c] = weight[depth];
+        } else {
+            saved_last[depth] = last[c];
+            cost += weight[depth] - last[c];
+            last[c] = weight[depth];
+            if (members[c].size() == 1) singles--;
+        }
+        members[c].push_back(v);
+        label[v] = c;
+        depth++;
+    }
+
+    void undo(const vector<uint32_t>& order) {
+        depth--;
+        const uint32_t v = order[depth];
+        const uint32_t c = label[v];
+        label[v] = NONE;
+        members[c].pop_back();
+        cost = saved_cost[depth];
+        if (members[c].empty()) {
+            opened--;
+            singles--;
+        } else {
+            last[c] = saved_last[depth];
+            if (members[c].size() == 1) singles++;
+        }
+    }
+
+    void reset(const vector<uint32_t>& order) {
+        while (depth > 0) {
+            undo(order);
+        }
+    }
+
+    void conta_no() {
+        if (++local_nodes % NODE_BATCH != 0) {
+            return;
+        }
+        const uint64_t total = shared->nodes.fetch_add(NODE_BATCH, memory_order_relaxed) + NODE_BATCH;
+        if (shared->node_limit > 0 && total >= shared->node_limit) {
+            shared->stop.store(true, memory_order_relaxed);
+        }
+        if (shared->time_limit > 0 &&
+            chrono::duration<double>(Clock::now() - shared->start).count() >= shared->time_limit) {
+            shared->stop.store(true, memory_order_relaxed);
+        }
+    }
+};
+
+BranchAndBound::BranchAndBound(const CSR& graph, const WeightOrder& order, size_t num_clusters)
+    : _graph(graph), _n(graph.size()), _p(num_clusters), _order(order.order), _incumbent(INF), _best(INF) {
+    _weight.assign(order.sorted.begin(), order.sorted.end());
+
+    // Somas de sufixo das diferenças e das j maiores diferenças de cada sufixo
+    _suffix.assign(_n + 1, 0);
+    _top.assign((_n + 1) * (_p + 1), 0);
+    vector<double> largest; // até p maiores diferenças do sufixo, em ordem decrescente
+    for (size_t s = _n; s-- > 0;) {
+        const double hole = s > 0 ? _weight[s] - _weight[s - 1] : 0;
+        _suffix[s] = _suffix[s + 1] + hole;
+        largest.insert(upper_bound(largest.begin(), largest.end(), hole, greater<double>()), hole);
+        if (largest.size() > _p) {
+            largest.pop_back();
+        }
+        double sum = 0;
+        for (size_t j = 1; j <= _p; ++j) {
+            if (j <= largest.size()) sum += largest[j - 1];
+            _top[s * (_p + 1) + j] = sum;
+        }
+    }
+}
+
+// Limite para o custo ainda por vir a partir da posição position com opened clusters abertos
+double BranchAndBound::resto(size_t position, size_t opened) const {
+    return _suffix[position] - _top[position * (_p + 1) + (_p - opened)];
+}
+
+// Verificação completa: componentes dos vértices livres e, para cada cluster,
+// se suas partes se ligam por esses componentes
+bool BranchAndBound::viavel(SearchWorker& worker) {
+    const CSR& g = _graph;
+    const size_t n = _n;
+    vector<uint32_t>& component = worker.component;
+    worker.component_size.clear();
+    worker.component_touched.clear();
+
+    for (size_t s = worker.depth; s < n; ++s) {
+        component[_order[s]] = NONE;
+    }
+    for (size_t s = worker.depth; s < n; ++s) {
+        const uint32_t root = _order[s];
+        if (component[root] != NONE) continue;
+        const uint32_t id = worker.component_size.size();
+        size_t head = 0, tail = 0;
+        worker.queue[tail++] = root;
+        component[root] = id;
+        while (head < tail) {
+            const uint32_t u = worker.queue[head++];
+            for (const uint32_t* b = g.begin(u); b != g.end(u); ++b) {
+                if (worker.label[*b] == NONE && component[*b] == NONE) {
+                    component[*b] = id;
+                    worker.queue[tail++] = *b;
+                }
+            }
+        }
+        worker.component_size.push_back(tail);
+        worker.component_touched.push_back(0);
+    }
+
+    for (uint32_t c = 0; c < worker.opened; ++c) {
+        const vector<uint32_t>& cluster = worker.members[c];
+        if (++worker.generation == 0) {
+            fill(worker.stamp.begin(), worker.stamp.end(), 0);
+            worker.generation = 1;
+        }
+        for (uint32_t a : cluster) {
+            worker.parent[a] = a;
+        }
+        bool grows = false;
+        for (uint32_t a : cluster) {
+            for (const uint32_t* b = g.begin(a); b != g.end(a); ++b) {
+                if (worker.label[*b] == c) {
+                    worker.unite(a, *b);
+                } else if (worker.label[*b] == NONE) {
+                    const uint32_t node = n + component[*b];
+                    if (worker.stamp[node] != worker.generation) {
+                        worker.stamp[node] = worker.generation;
+                        worker.parent[node] = node;
+                    }
+                    worker.unite(a, node);
+                    worker.component_touched[component[*b]] = 1;
+                    grows = true;
+                }
+            }
+        }
+        const uint32_t root = worker.find(cluster[0]);
+        for (uint32_t a : cluster) {
+            if (worker.find(a) != root) return false;
+        }
+        if (cluster.size() == 1 && !grows) {
+            return false;
+        }
+    }
+
+    // Componentes livres sem cluster vizinho viram clusters novos inteiros
+    size_t isolated = 0;
+    for (size_t id = 0; id < worker.component_size.size(); ++id) {
+        if (worker.component_touched[id]) continue;
+        if (worker.component_size[id] < 2) return false;
+        isolated++;
+    }
+    return isolated <= _p - worker.opened;
+}
+
+// Depois de v entrar em c: decide se a atribuição preserva a viabilidade
+// olhando só a vizinhança de v, ou recorre à verificação completa
+bool BranchAndBound::viavel_local(SearchWorker& worker, uint32_t v, uint32_t c, bool opened) {
+    const CSR& g = _graph;
+    size_t free_neighbors = 0;
+    size_t paths = 0; // vizinhos livres ou em outros clusters
+    bool touches_cluster = false;
+    bool full = opened;
+    for (const uint32_t* b = g.begin(v); b != g.end(v); ++b) {
+        const uint32_t other = worker.label[*b];
+        if (other == NONE) {
+            free_neighbors++;
+            paths++;
+        } else if (other == c) {
+            touches_cluster = true;
+        } else {
+            paths++;
+            if (worker.members[other].size() == 1) full = true;
+        }
+    }
+    if (opened && free_neighbors == 0) {
+        return false;
+    }
+    if (!opened && !touches_cluster) full = true;
+    if (paths >= 2) full = true;
+    return full ? viavel(worker) : true;
+}
+
+// Melhor partição até aqui (folha com custo menor que o incumbente)
+void BranchAndBound::registra(SearchWorker& worker) {
+    lock_guard<mutex> lock(_best_mutex);
+    if (worker.cost >= _best) {
+        return;
+    }
+    _best = worker.cost;
+    _best_clusters.assign(worker.members.begin(), worker.members.begin() + worker.opened);
+    double seen = _incumbent.load();
+    while (worker.cost < seen && !_incumbent.compare_exchange_weak(seen, worker.cost)) {
+    }
+}
+
+void BranchAndBound::explora(SearchWorker& worker) {
+    SharedSearch& shared = *worker.shared;
+    worker.conta_no();
+    const size_t t = worker.depth;
+    if (t == _n) {
+        registra(worker);
+        return;
+    }
+
+    // Opções: entrar em cada cluster aberto ou abrir um novo, em ordem de limite
+    vector<Option>& options = worker.options[t];
+    options.clear();
+    const size_t remaining = _n - t - 1;
+    for (uint32_t c = 0; c <= worker.opened && c < _p; ++c) {
+        const bool opens = c == worker.opened;
+        const size_t opened = worker.opened + (opens ? 1 : 0);
+        size_t singles = worker.singles;
+        if (opens) singles++;
+        else if (worker.members[c].size() == 1) singles--;
+        if (singles + 2 * (_p - opened) > remaining) continue;
+        const double increment = opens ? 0 : _weight[t] - worker.last[c];
+        options.push_back({ c, worker.cost + increment + resto(t + 1, opened) });
+    }
+    sort(options.begin(), options.end(), [](const Option& a, const Option& b) {
+        return a.bound < b.bound || (a.bound == b.bound && a.cluster < b.cluster);
+    });
+
+    for (size_t i = 0; i < options.size(); ++i) {
+        if (shared.stop.load(memory_order_relaxed)) {
+            for (size_t j = i; j < options.size(); ++j) {
+                worker.open_bound = min(worker.open_bound, options[j].bound);
+            }
+            return;
+        }
+        if (!promissor(options[i].bound, _incumbent.load(memory_order_relaxed))) {
+            break;
+        }
+
+        // Doar os irmãos restantes se há worker ocioso e a própria fila está vazia
+        if (i + 1 < options.size() && shared.idle.load(memory_order_relaxed) > 0 &&
+            shared.queues[worker.id]->size.load(memory_order_relaxed) == 0) {
+            TaskQueue& queue = *shared.queues[worker.id];
+            lock_guard<mutex> lock(queue.lock);
+            for (size_t j = i + 1; j < options.size(); ++j) {
+                Task task;
+                task.prefix.resize(t + 1);
+                for (size_t s = 0; s < t; ++s) {
+                    task.prefix[s] = worker.label[_order[s]];
+                }
+                task.prefix[t] = options[j].cluster;
+                task.bound = options[j].bound;
+                shared.pending.fetch_add(1);
+                queue.tasks.push_back(move(task));
+            }
+            queue.size.store(queue.tasks.size(), memory_order_relaxed);
+            options.resize(i + 1);
+        }
+
+        const uint32_t c = options[i].cluster;
+        const bool opens = c == worker.opened;
+        worker.assign(_order, _weight, c);
+        if (viavel_local(worker, _order[t], c, opens)) {
+            explora(worker);
+        }
+        worker.undo(_order);
+    }
+}
+
+bool BranchAndBound::run(double incumbent, const ExactConfig& config, ExactStats& stats) {
+    INSTRUMENT_PHASE("exato");
+    const Clock::time_point start = Clock::now();
+    _incumbent.store(incumbent);
+    _best = incumbent;
+    _best_clusters.clear();
+    stats = ExactStats();
+
+    ThreadPool pool(max<size_t>(config.threads, 1));
+    const size_t threads = pool.size();
+    SharedSearch shared;
+    shared.node_limit = config.node_limit;
+    shared.time_limit = config.time_limit;
+    shared.start = start;
+    for (size_t w = 0; w < threads; ++w) {
+        shared.queues.emplace_back(new TaskQueue());
+    }
+    vector<unique_ptr<SearchWorker>> workers;
+    for (size_t w = 0; w < threads; ++w) {
+        workers.emplace_back(new SearchWorker(&shared, w, _n, _p));
+    }
+
+    // Raiz: nenhum vértice atribuído
+    const double root_bound = resto(0, 0);
+    shared.queues[0]->tasks.push_back({ vector<uint32_t>(), root_bound });
+    shared.queues[0]->size.store(1);
+    shared.pending.store(1);
+
+    pool.run([&](size_t w) {
+        SearchWorker& worker = *workers[w];
+        bool hungry = false;
+        while (!shared.stop.load(memory_order_relaxed)) {
+            // Própria fila pelo fim; senão rouba pelo início da fila dos outros
+            Task task;
+            bool found = false;
+            for (size_t k = 0; k < threads && !found; ++k) {
+                TaskQueue& queue = *shared.queues[(w + k) % threads];
+                if (queue.size.load(memory_order_relaxed) == 0) continue;
+                lock_guard<mutex> lock(queue.lock);
+                if (queue.tasks.empty()) continue;
+                if (k == 0) {
+                    task = move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                } else {
+                    task = move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                    shared.steals.fetch_add(1, memory_order_relaxed);
+                }
+                queue.size.store(queue.tasks.size(), memory_order_relaxed);
+                found = true;
+            }
+            if (!found) {
+                if (shared.pending.load() == 0) break;
+                if (!hungry) {
+                    hungry = true;
+                    shared.idle.fetch_add(1);
+                }
+                this_thread::yield();
+                continue;
+            }
+            if (hungry) {
+                hungry = false;
+                shared.idle.fetch_sub(1);
+            }
+
+            // Refazer o prefixo da subárvore e conferir a viabilidade uma vez
+            worker.reset(_order);
+            for (uint32_t c : task.prefix) {
+                worker.assign(_order, _weight, c);
+            }
+            if (promissor(task.bound, _incumbent.load(memory_order_relaxed)) && viavel(worker)) {
+                explora(worker);
+            }
+            shared.pending.fetch_sub(1);
+        }
+        if (hungry) {
+            shared.idle.fetch_sub(1);
+        }
+    });
+
+    // Subárvores não terminadas (parada por tempo ou nós) limitam o que falta provar
+    double open_bound = INF;
+    for (size_t w = 0; w < threads; ++w) {
+        open_bound = min(open_bound, workers[w]->open_bound);
+        shared.nodes.fetch_add(workers[w]->local_nodes % NODE_BATCH);
+        for (const Task& task : shared.queues[w]->tasks) {
+            open_bound = min(open_bound, task.bound);
+        }
+    }
+    stats.nos = shared.nodes.load();
+    INSTRUMENT_ADD(ITERACOES, stats.nos);
+    stats.roubos = shared.steals.load();
+    stats.provado = !shared.stop.load() || (shared.pending.load() == 0 && open_bound == INF);
+    stats.limite = stats.provado ? _best : min(_best, open_bound);
+    stats.tempo = chrono::duration<double>(Clock::now() - start).count();
+    return !_best_clusters.empty();
+}
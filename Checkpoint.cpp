@@ -0,0 +1,306 @@
+#include "include/Checkpoint.hpp"
+#include "include/defines.hpp"
+
+#include <cstdio>
+
+using namespace std;
+
+namespace {
+
+const char CHECKPOINT_MAGIC[8] = { 'T', 'D', 'G', 'R', 'A', 'F', 'O', 'C' };
+const uint32_t CHECKPOINT_BYTE_ORDER = 0x01020304;
+
+// Acrescenta valores triviais ao buffer, campo a campo (sem o preenchimento das structs)
+class Escrita
+{
+public:
+    template <typename T>
+    void valor(const T& value) {
+        _data.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void vetor(const vector<T>& values) {
+        valor<uint64_t>(values.size());
+        _data.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    string& data() { return _data; }
+
+private:
+    string _data;
+};
+
+// Lê na mesma ordem da Escrita; qualquer leitura além do fim invalida o resto
+class Leitura
+{
+public:
+    Leitura(const string& data) : _data(data), _position(0), _ok(true) {}
+
+    template <typename T>
+    void valor(T& value) {
+        if (!_ok || _data.size() - _position < sizeof(T)) {
+            _ok = false;
+            return;
+        }
+        memcpy(&value, _data.data() + _position, sizeof(T));
+        _position += sizeof(T);
+    }
+
+    template <typename T>
+    void vetor(vector<T>& values) {
+        uint64_t size = 0;
+        valor(size);
+        if (!_ok || size > (_data.size() - _position) / sizeof(T)) {
+            _ok = false;
+            return;
+        }
+        values.resize(size);
+        memcpy(values.data(), _data.data() + _position, size * sizeof(T));
+        _position += size * sizeof(T);
+    }
+
+    // Quantidade de itens de uma lista, limitada pelo que ainda resta no arquivo
+    uint64_t tamanho(size_t minimum_item_size) {
+        uint64_t size = 0;
+        valor(size);
+        if (!_ok || size > (_data.size() - _position) / minimum_item_size) {
+            _ok = false;
+            return 0;
+        }
+        return size;
+    }
+
+    bool ok() const { return _ok; }
+    bool fim() const { return _position == _data.size(); }
+
+private:
+    const string& _data;
+    size_t        _position;
+    bool          _ok;
+};
+
+} // namespace
+
+string serializa_checkpoint(const GraspCheckpoint& checkpoint) {
+    Escrita out;
+    out.data().append(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+    out.valor(CHECKPOINT_VERSION);
+    out.valor(CHECKPOINT_BYTE_ORDER);
+
+    out.valor(checkpoint.num_vertices);
+    out.valor(checkpoint.num_clusters);
+    out.valor(checkpoint.threads);
+    out.valor(checkpoint.seed);
+    out.valor(checkpoint.update_period);
+    out.vetor(checkpoint.alphas);
+    out.valor(checkpoint.elite_size);
+    out.valor(checkpoint.elite_diversity);
+
+    out.valor(checkpoint.next_block);
+    out.valor(checkpoint.elapsed);
+    out.valor(checkpoint.incumbent);
+    out.valor(checkpoint.published);
+    out.vetor(checkpoint.gaps_per_alpha);
+    out.vetor(checkpoint.counts_per_alpha);
+    out.vetor(checkpoint.probabilities);
+    out.valor<uint64_t>(checkpoint.improvements.size());
+    for (const IncumbentRecord& record : checkpoint.improvements) {
+        out.valor<uint64_t>(record.iteracao);
+        out.valor(record.gap);
+        out.valor(record.segundos);
+    }
+
+    out.valor<uint64_t>(checkpoint.workers.size());
+    for (const GraspWorkerState& worker : checkpoint.workers) {
+        for (uint64_t word : worker.rng) {
+            out.valor(word);
+        }
+        out.valor(worker.best_gap);
+        out.valor(worker.best_iter);
+        out.valor(worker.executed);
+        out.valor<uint64_t>(worker.best_subgraphs.size());
+        for (const Subgraph& subgraph : worker.best_subgraphs) {
+            out.valor<uint64_t>(subgraph.vertices.size());
+            for (size_t vertex : subgraph.vertices) {
+                out.valor<uint64_t>(vertex);
+            }
+            out.valor(subgraph.max_weight);
+            out.valor(subgraph.min_weight);
+            out.valor(subgraph.total_weight);
+        }
+        out.valor<uint64_t>(worker.trace.size());
+        for (const IterationRecord& record : worker.trace) {
+            out.valor<uint64_t>(record.iteracao);
+            out.valor(record.alpha);
+            out.valor(record.gap);
+        }
+    }
+
+    out.valor<uint64_t>(checkpoint.elite.size());
+    for (const EliteSolution& member : checkpoint.elite) {
+        out.vetor(member.label);
+        out.valor(member.gap);
+        out.valor(member.iteration);
+    }
+    return move(out.data());
+}
+
+bool le_checkpoint(const string& path, GraspCheckpoint& checkpoint) {
+    ifstream input(path, ios::binary);
+    if (!input) {
+        return false;
+    }
+    const string data((istreambuf_iterator<char>(input)), istreambuf_iterator<char>());
+    if (data.size() < sizeof(CHECKPOINT_MAGIC) || memcmp(data.data(), CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC)) != 0) {
+        return false;
+    }
+
+    Leitura in(data);
+    char magic[sizeof(CHECKPOINT_MAGIC)];
+    uint32_t version = 0, byte_order = 0;
+    in.valor(magic);
+    in.valor(version);
+    in.valor(byte_order);
+    if (version != CHECKPOINT_VERSION || byte_order != CHECKPOINT_BYTE_ORDER) {
+        return false;
+    }
+
+    GraspCheckpoint result;
+    in.valor(result.num_vertices);
+    in.valor(result.num_clusters);
+    in.valor(result.threads);
+    in.valor(result.seed);
+    in.valor(result.update_period);
+    in.vetor(result.alphas);
+    in.valor(result.elite_size);
+    in.valor(result.elite_diversity);
+
+    in.valor(result.next_block);
+    in.valor(result.elapsed);
+    in.valor(result.incumbent);
+    in.valor(result.published);
+    in.vetor(result.gaps_per_alpha);
+    in.vetor(result.counts_per_alpha);
+    in.vetor(result.probabilities);
+    result.improvements.resize(in.tamanho(sizeof(uint64_t) + sizeof(float) + sizeof(double)));
+    for (IncumbentRecord& record : result.improvements) {
+        uint64_t iteration = 0;
+        in.valor(iteration);
+        in.valor(record.gap);
+        in.valor(record.segundos);
+        record.iteracao = iteration;
+    }
+
+    result.workers.resize(in.tamanho(4 * sizeof(uint64_t)));
+    for (GraspWorkerState& worker : result.workers) {
+        for (uint64_t& word : worker.rng) {
+            in.valor(word);
+        }
+        in.valor(worker.best_gap);
+        in.valor(worker.best_iter);
+        in.valor(worker.executed);
+        worker.best_subgraphs.resize(in.tamanho(sizeof(uint64_t) + 3 * sizeof(float)));
+        for (Subgraph& subgraph : worker.best_subgraphs) {
+            subgraph.vertices.resize(in.tamanho(sizeof(uint64_t)));
+            for (size_t& vertex : subgraph.vertices) {
+                uint64_t value = 0;
+                in.valor(value);
+                vertex = value;
+            }
+            in.valor(subgraph.max_weight);
+            in.valor(subgraph.min_weight);
+            in.valor(subgraph.total_weight);
+        }
+        worker.trace.resize(in.tamanho(sizeof(uint64_t) + 2 * sizeof(float)));
+        for (IterationRecord& record : worker.trace) {
+            uint64_t iteration = 0;
+            in.valor(iteration);
+            in.valor(record.alpha);
+            in.valor(record.gap);
+            record.iteracao = iteration;
+        }
+    }
+
+    result.elite.resize(in.tamanho(sizeof(uint64_t) + sizeof(float) + sizeof(uint64_t)));
+    for (EliteSolution& member : result.elite) {
+        in.vetor(member.label);
+        in.valor(member.gap);
+        in.valor(member.iteration);
+    }
+
+    const size_t num_alphas = result.alphas.size();
+    if (!in.ok() || !in.fim() || result.gaps_per_alpha.size() != num_alphas ||
+        result.counts_per_alpha.size() != num_alphas || result.probabilities.size() != num_alphas) {
+        return false;
+    }
+    checkpoint = move(result);
+    return true;
+}
+
+CheckpointWriter::CheckpointWriter(const string& path)
+    : _path(path), _has_pending(false), _writing(false), _stop(false) {
+    _thread = thread(&CheckpointWriter::loop, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _stop = true;
+    }
+    _ready.notify_one();
+    _thread.join();
+}
+
+void CheckpointWriter::write(GraspCheckpoint&& checkpoint) {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _pending = move(checkpoint);
+        _has_pending = true;
+    }
+    _ready.notify_one();
+}
+
+void CheckpointWriter::flush() {
+    unique_lock<mutex> lock(_mutex);
+    _drained.wait(lock, [this] { return !_has_pending && !_writing; });
+}
+
+// Grava num arquivo temporário e renomeia: quem retoma vê o checkpoint antigo ou o novo inteiro
+bool CheckpointWriter::grava(const string& data) {
+    const string temporary = _path + ".tmp";
+    {
+        ofstream output(temporary, ios::binary | ios::trunc);
+        if (!output || !output.write(data.data(), data.size()) || !output.flush()) {
+            cerr << "Erro ao gravar o checkpoint: " << temporary << "\n";
+            return false;
+        }
+    }
+    if (rename(temporary.c_str(), _path.c_str()) != 0) {
+        cerr << "Erro ao gravar o checkpoint: " << _path << "\n";
+        return false;
+    }
+    return true;
+}
+
+void CheckpointWriter::loop() {
+    GraspCheckpoint checkpoint;
+    unique_lock<mutex> lock(_mutex);
+    while (true) {
+        _ready.wait(lock, [this] { return _stop || _has_pending; });
+        if (!_has_pending) {
+            break;
+        }
+        swap(checkpoint, _pending);
+        _has_pending = false;
+        _writing = true;
+        lock.unlock();
+
+        grava(serializa_checkpoint(checkpoint));
+
+        lock.lock();
+        _writing = false;
+        _drained.notify_all();
+    }
+    _drained.notify_all();
+}
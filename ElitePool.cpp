@@ -0,0 +1,190 @@
+#include "include/ElitePool.hpp"
+#include "include/Instrument.hpp"
+#include "include/Partition.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+size_t PartitionMatch::match(const vector<uint32_t>& a, const vector<uint32_t>& b, size_t num_clusters) {
+    const uint32_t NONE = Partition::NONE;
+    _keys.clear();
+    for (size_t v = 0; v < a.size(); ++v) {
+        if (a[v] != NONE && b[v] != NONE) {
+            _keys.push_back((uint64_t)a[v] * num_clusters + b[v]);
+        }
+    }
+    sort(_keys.begin(), _keys.end());
+
+    _pairs.clear();
+    for (size_t i = 0; i < _keys.size(); ) {
+        size_t j = i;
+        while (j < _keys.size() && _keys[j] == _keys[i]) ++j;
+        _pairs.emplace_back((uint32_t)(j - i), _keys[i]);
+        i = j;
+    }
+    // Mais vértices em comum primeiro; empates pela chave, para não depender da ordenação
+    sort(_pairs.begin(), _pairs.end(), [](const pair<uint32_t, uint64_t>& x, const pair<uint32_t, uint64_t>& y) {
+        return x.first != y.first ? x.first > y.first : x.second < y.second;
+    });
+
+    _b_to_a.assign(num_clusters, NONE);
+    _a_used.assign(num_clusters, 0);
+    size_t matched = 0;
+    for (const pair<uint32_t, uint64_t>& item : _pairs) {
+        const uint32_t ca = item.second / num_clusters;
+        const uint32_t cb = item.second % num_clusters;
+        if (!_a_used[ca] && _b_to_a[cb] == NONE) {
+            _a_used[ca] = 1;
+            _b_to_a[cb] = ca;
+            matched += item.first;
+        }
+    }
+    return _keys.size() - matched;
+}
+
+ElitePool::ElitePool(size_t capacity, size_t min_distance, size_t num_clusters)
+    : _capacity(capacity), _min_distance(min_distance), _num_clusters(num_clusters) {
+    _members.reserve(capacity);
+}
+
+bool ElitePool::accepts(float gap) const {
+    if (_capacity == 0) return false;
+    if (_members.size() < _capacity) return true;
+    for (const EliteSolution& member : _members) {
+        if (gap < member.gap) return true;
+    }
+    return false;
+}
+
+bool ElitePool::offer(const vector<uint32_t>& label, float gap, uint64_t iteration) {
+    if (!accepts(gap)) {
+        return false;
+    }
+    size_t closest = 0;
+    size_t closest_distance = numeric_limits<size_t>::max();
+    size_t worst = 0;
+    for (size_t i = 0; i < _members.size(); ++i) {
+        const size_t distance = _match.match(_members[i].label, label, _num_clusters);
+        if (distance < closest_distance) {
+            closest_distance = distance;
+            closest = i;
+        }
+        if (_members[i].gap > _members[worst].gap) {
+            worst = i;
+        }
+    }
+
+    size_t slot;
+    if (closest_distance < _min_distance) {
+        // Parecida demais com um membro: só o substitui se for melhor
+        if (gap >= _members[closest].gap) return false;
+        slot = closest;
+    } else if (_members.size() < _capacity) {
+        slot = _members.size();
+        _members.emplace_back();
+    } else {
+        slot = worst;
+    }
+    EliteSolution& member = _members[slot];
+    member.label = label;
+    member.gap = gap;
+    member.iteration = iteration;
+    return true;
+}
+
+void PathRelinker::push(const LocalSearch& search, uint32_t i) {
+    const uint32_t v = _pending[i];
+    const uint32_t from = search.label(v);
+    _heap.push_back(Candidate{ search.relocate_delta(v, _target[i]), i, _generation[i], _version[from], _version[_target[i]] });
+    push_heap(_heap.begin(), _heap.end());
+}
+
+float PathRelinker::run(LocalSearch& search, const vector<uint32_t>& guide, Deadline deadline) {
+    INSTRUMENT_PHASE("relinking");
+    const uint32_t NONE = Partition::NONE;
+    const vector<uint32_t>& label = search.labels();
+    const size_t p = search.num_clusters();
+    _match.match(label, guide, p);
+
+    _pending.clear();
+    _target.clear();
+    for (uint32_t v = 0; v < label.size(); ++v) {
+        if (label[v] == NONE || guide[v] == NONE) continue;
+        const uint32_t to = _match.mapped(guide[v]);
+        if (to != NONE && to != label[v]) {
+            _pending.push_back(v);
+            _target.push_back(to);
+        }
+    }
+    _generation.assign(_pending.size(), 0);
+    _done.assign(_pending.size(), 0);
+    _version.assign(p, 0);
+    _waiting.resize(p);
+    for (vector<pair<uint32_t, uint32_t>>& waiting : _waiting) {
+        waiting.clear();
+    }
+    _heap.clear();
+    for (uint32_t i = 0; i < _pending.size(); ++i) {
+        push(search, i);
+    }
+
+    _moves.clear();
+    float gap = search.total_gap();
+    float best_gap = gap;
+    size_t best_step = 0;
+    const bool timed = deadline != Deadline::max();
+    for (size_t step = 0; !_heap.empty(); ++step) {
+        if (timed && step % 64 == 0 && chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        pop_heap(_heap.begin(), _heap.end());
+        const Candidate candidate = _heap.back();
+        _heap.pop_back();
+        const uint32_t i = candidate.index;
+        if (_done[i] || candidate.generation != _generation[i]) {
+            continue;
+        }
+        const uint32_t v = _pending[i];
+        const uint32_t from = label[v];
+        const uint32_t to = _target[i];
+        // Algum dos dois clusters mudou desde a avaliação: reavaliar
+        if (candidate.from_version != _version[from] || candidate.to_version != _version[to]) {
+            push(search, i);
+            continue;
+        }
+        // Impossível por enquanto: espera até um dos dois clusters mudar
+        if (!search.can_relocate(v, to)) {
+            ++_generation[i];
+            _waiting[from].emplace_back(i, _generation[i]);
+            _waiting[to].emplace_back(i, _generation[i]);
+            continue;
+        }
+
+        gap += candidate.delta;
+        _moves.emplace_back(v, from);
+        search.relocate(v, to);
+        _done[i] = 1;
+        ++_version[from];
+        ++_version[to];
+        if (gap < best_gap) {
+            best_gap = gap;
+            best_step = _moves.size();
+        }
+        for (uint32_t c : { from, to }) {
+            for (const pair<uint32_t, uint32_t>& waiting : _waiting[c]) {
+                if (!_done[waiting.first] && _generation[waiting.first] == waiting.second) {
+                    ++_generation[waiting.first];
+                    push(search, waiting.first);
+                }
+            }
+            _waiting[c].clear();
+        }
+    }
+
+    // Voltar ao melhor ponto desfazendo os movimentos seguintes, do último para o primeiro
+    while (_moves.size() > best_step) {
+        search.relocate(_moves.back().first, _moves.back().second);
+        _moves.pop_back();
+    }
+    return search.total_gap();
+}
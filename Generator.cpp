@@ -0,0 +1,499 @@
+#include "include/Generator.hpp"
+#include "include/Batch.hpp"
+#include "include/Loader.hpp"
+#include "include/Random.hpp"
+#include "include/defines.hpp"
+
+#include <charconv>
+#include <filesystem>
+
+using namespace std;
+
+namespace {
+
+// Finalizador do splitmix64: espalha chaves vizinhas por todo o intervalo
+uint64_t mistura(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Real em [0, 1) a partir de 53 bits de um hash
+double fracao(uint64_t bits) {
+    return (bits >> 11) * 0x1.0p-53;
+}
+
+size_t num_clusters(const GeneratorConfig& config) {
+    const double n = (double)config.num_vertices;
+    if (config.clusters == "p1") return (size_t)max(1.0, round(log(n)));
+    if (config.clusters == "p2") return (size_t)max(1.0, round(sqrt(n)));
+    if (config.clusters == "p3") return (size_t)max(1.0, round(n / log(n)));
+    size_t p = 0;
+    return le_numero(config.clusters, p) ? p : 0;
+}
+
+// Confere a configuração; a mensagem vai para erro
+bool valida(const GeneratorConfig& config, string& erro) {
+    const size_t n = config.num_vertices;
+    if (n < 4 || n >= numeric_limits<uint32_t>::max()) {
+        erro = "O número de vértices deve estar entre 4 e 2^32 - 2.";
+    } else if (config.family != "d03" && config.family != "d06" && config.family != "pla") {
+        erro = "Família desconhecida: " + config.family + " (use d03, d06 ou pla).";
+    } else if (config.density > 1 || (config.density >= 0 && config.family == "pla")) {
+        erro = "A densidade vale só para as famílias d e deve estar em [0, 1].";
+    } else if (config.degree == 0 || (config.degree > 0 && config.density >= 0)) {
+        erro = "Informe a densidade ou o grau médio, não os dois; o grau deve ser positivo.";
+    } else if (config.weights != "uniforme" && config.weights != "exponencial" && config.weights != "loguniforme") {
+        erro = "Distribuição de pesos desconhecida: " + config.weights + ".";
+    } else if (config.max_weight < 0 || (config.max_weight > 0 && config.max_weight < 1)) {
+        erro = "O peso máximo deve ser pelo menos 1.";
+    } else if (num_clusters(config) == 0 || num_clusters(config) > n / 2) {
+        erro = "Número de clusters inválido: " + config.clusters + " (p1, p2, p3 ou um número até n / 2).";
+    } else {
+        return true;
+    }
+    return false;
+}
+
+// As arestas vêm em linhas independentes (uma por vértice da família), cada uma
+// com o seu próprio fluxo aleatório, então qualquer linha pode ser gerada de
+// novo sem as anteriores
+class Gerador
+{
+public:
+    explicit Gerador(const GeneratorConfig& config);
+
+    size_t size() const { return _n; }
+
+    // Arestas (a, b) da linha row (0 <= row < n), em índices densos; nenhuma
+    // aresta aparece duas vezes no grafo
+    void linha(size_t row, vector<pair<uint32_t, uint32_t>>& edges) const;
+
+    // Chama f(v, peso) para v = 0..n-1, com os pesos em ordem crescente
+    template <typename F>
+    void pesos(F&& f) const;
+
+private:
+    void linha_densa(size_t row, vector<pair<uint32_t, uint32_t>>& edges) const;
+    void linha_planar(size_t row, vector<pair<uint32_t, uint32_t>>& edges) const;
+    uint32_t posicao(uint64_t cell) const;
+    float peso(double quantile) const;
+
+    size_t   _n;
+    bool     _planar;
+    double   _density;
+    double   _keep;       // pla: probabilidade de manter uma aresta opcional da grade
+    size_t   _width;      // pla: largura da grade
+    unsigned _half_bits;  // pla: metade dos bits da permutação dos vértices
+    string   _weights;
+    double   _max_weight;
+    uint64_t _seed;       // semente já misturada
+};
+
+Gerador::Gerador(const GeneratorConfig& config)
+    : _n(config.num_vertices), _planar(config.family == "pla"), _density(0), _keep(1), _width(0), _half_bits(1),
+      _weights(config.weights), _max_weight(config.max_weight > 0 ? floor(config.max_weight) : (double)config.num_vertices),
+      _seed(mistura(config.seed)) {
+    const double n = (double)_n;
+    if (!_planar) {
+        _density = config.density >= 0 ? config.density
+                 : config.degree > 0   ? min(1.0, config.degree / (n - 1))
+                 : config.family == "d03" ? 1.0 / 3 : 2.0 / 3;
+        return;
+    }
+    // Grade com largura ceil(raiz de n): as n - 1 arestas do pente (linhas
+    // inteiras mais a primeira coluna) ficam sempre; as outras descidas e as
+    // diagonais ficam com a probabilidade que leva ao grau médio pedido
+    _width = (size_t)ceil(sqrt(n));
+    const double height = ceil(n / _width);
+    const double optional = (n - _width - height + 1) + (height - 1) * (_width - 1);
+    const double target = (config.degree > 0 ? config.degree : 5.7) * n / 2;
+    _keep = optional > 0 ? min(1.0, max(0.0, (target - (n - 1)) / optional)) : 1;
+    while ((uint64_t(1) << (2 * _half_bits)) < _n) ++_half_bits;
+}
+
+// Permutação de [0, n) por uma rede de Feistel de quatro rodadas sobre 2 * _half_bits
+// bits, reaplicada enquanto cair fora de [0, n): numera a grade em ordem aleatória
+// sem guardar a permutação
+uint32_t Gerador::posicao(uint64_t cell) const {
+    const uint64_t mask = (uint64_t(1) << _half_bits) - 1;
+    uint64_t x = cell;
+    do {
+        for (uint64_t round = 0; round < 4; ++round) {
+            const uint64_t left = x >> _half_bits;
+            const uint64_t right = x & mask;
+            x = (right << _half_bits) | (left ^ (mistura(_seed ^ (round << 60) ^ right) & mask));
+        }
+    } while (x >= _n);
+    return (uint32_t)x;
+}
+
+// Amostragem por saltos (Batagelj e Brandes): a distância até o próximo vizinho
+// é geométrica, então a linha custa O(1 + grau) e não O(n)
+void Gerador::linha_densa(size_t row, vector<pair<uint32_t, uint32_t>>& edges) const {
+    const uint64_t u = row;
+    if (u + 1 >= _n) return;
+    Random rng(mistura(_seed + u));
+    // Um vizinho de índice maior garantido: o grafo fica conexo
+    const uint64_t tree = u + 1 + rng.uniform(_n - u - 1);
+    bool tree_done = false;
+    const double log_q = log1p(-_density);
+    uint64_t v = u;
+    while (_density > 0) {
+        const double skip = _density >= 1 ? 0 : floor(log1p(-rng.real()) / log_q);
+        if (skip >= (double)(_n - v - 1)) break;
+        v += 1 + (uint64_t)skip;
+        if (!tree_done && tree <= v) {
+            if (tree < v) edges.emplace_back(u, tree);
+            tree_done = true;
+        }
+        edges.emplace_back(u, v);
+    }
+    if (!tree_done) {
+        edges.emplace_back(u, tree);
+    }
+}
+
+// A célula (r, c) da grade liga (r, c) a (r, c + 1) e (r + 1, c) e recebe uma das
+// duas diagonais por sorteio; a linha da célula emite as arestas que saem dela
+void Gerador::linha_planar(size_t row, vector<pair<uint32_t, uint32_t>>& edges) const {
+    const uint64_t g = row;
+    const uint64_t c = g % _width;
+    const uint32_t self = posicao(g);
+    auto aresta = [&](uint64_t other, uint64_t key, bool optional) {
+        if (other < _n && (!optional || fracao(mistura(_seed + 5 * g + key)) < _keep)) {
+            edges.emplace_back(self, posicao(other));
+        }
+    };
+    auto diagonal_principal = [&](uint64_t cell) { return (mistura(_seed + 5 * cell + 3) & 1) == 0; };
+    if (c + 1 < _width) {
+        aresta(g + 1, 0, false);
+        if (diagonal_principal(g)) aresta(g + _width + 1, 1, true);
+    }
+    aresta(g + _width, 2, c != 0);
+    // A outra diagonal da célula à esquerda sai deste vértice
+    if (c > 0 && !diagonal_principal(g - 1)) {
+        aresta(g + _width - 1, 4, true);
+    }
+}
+
+void Gerador::linha(size_t row, vector<pair<uint32_t, uint32_t>>& edges) const {
+    edges.clear();
+    if (_planar) {
+        linha_planar(row, edges);
+    } else {
+        linha_densa(row, edges);
+    }
+}
+
+// Inverte a distribuição no quantil pedido; inteiro em [1, peso máximo]
+float Gerador::peso(double quantile) const {
+    double value;
+    if (_weights == "exponencial") {
+        // Exponencial com taxa 4 truncada em [0, 1)
+        const double rate = 4;
+        value = 1 + floor(_max_weight * -log1p(-quantile * -expm1(-rate)) / rate);
+    } else if (_weights == "loguniforme") {
+        value = floor(exp(quantile * log(_max_weight)));
+    } else {
+        value = 1 + floor(quantile * _max_weight);
+    }
+    return (float)min(max(value, 1.0), _max_weight);
+}
+
+// Estatísticas de ordem de n uniformes, da menor para a maior, uma de cada vez
+// (Bentley e Saxe): a próxima é a menor das n - v que restam acima da atual
+template <typename F>
+void Gerador::pesos(F&& f) const {
+    Random rng(mistura(_seed ^ 0x5045534f53ULL));
+    double quantile = 0;
+    for (size_t v = 0; v < _n; ++v) {
+        quantile = 1 - (1 - quantile) * exp(log1p(-rng.real()) / (double)(_n - v));
+        f(v, peso(quantile));
+    }
+}
+
+// Escrita com buffer próprio: o operator<< dos streams é lento para bilhões de números
+class Saida
+{
+public:
+    explicit Saida(const string& path) : _file(path, ios::binary | ios::trunc) {
+        _buffer.reserve(BUFFER);
+    }
+
+    bool ok() const { return bool(_file); }
+
+    Saida& texto(const string& value) {
+        _buffer.append(value);
+        return descarrega();
+    }
+
+    Saida& numero(uint64_t value) {
+        char digits[24];
+        _buffer.append(digits, to_chars(digits, digits + sizeof(digits), value).ptr);
+        return descarrega();
+    }
+
+    // Número alinhado à direita em width colunas, como nas instâncias
+    Saida& numero(uint64_t value, size_t width) {
+        char digits[24];
+        char* end = to_chars(digits, digits + sizeof(digits), value).ptr;
+        _buffer.append(width > size_t(end - digits) ? width - (end - digits) : 0, ' ');
+        _buffer.append(digits, end);
+        return descarrega();
+    }
+
+    Saida& bytes(const void* data, size_t size) {
+        _buffer.append(static_cast<const char*>(data), size);
+        return descarrega();
+    }
+
+    bool fecha() {
+        _file.write(_buffer.data(), _buffer.size());
+        _buffer.clear();
+        _file.close();
+        return !_file.fail();
+    }
+
+private:
+    static const size_t BUFFER = 1 << 20;
+
+    Saida& descarrega() {
+        if (_buffer.size() >= BUFFER) {
+            _file.write(_buffer.data(), _buffer.size());
+            _buffer.clear();
+        }
+        return *this;
+    }
+
+    ofstream _file;
+    string   _buffer;
+};
+
+size_t digitos(uint64_t value) {
+    size_t count = 1;
+    while (value >= 10) {
+        value /= 10;
+        ++count;
+    }
+    return count;
+}
+
+bool escreve_texto(const Gerador& gerador, const GeneratorConfig& config, const string& path) {
+    const size_t n = gerador.size();
+    const size_t p = num_clusters(config);
+    Saida out(path);
+    if (!out.ok()) {
+        cerr << "Erro ao criar o arquivo da instância: " << path << "\n";
+        return false;
+    }
+    out.texto("# " + filesystem::path(path).filename().string() + "\n\n# ").numero(p).texto(" cluster\nparam p := ").numero(p);
+    out.texto(" ;\n\n# ").numero(n).texto(" vertici\nset V := \n");
+    for (size_t v = 1; v <= n; ++v) {
+        out.texto(" ").numero(v);
+    }
+    out.texto("\n;\n\nparam w := \n");
+    const size_t id_width = digitos(n);
+    const size_t weight_width = max<size_t>(5, digitos((uint64_t)(config.max_weight > 0 ? config.max_weight : n)) + 2);
+    gerador.pesos([&](size_t v, float weight) {
+        out.numero(v + 1, id_width).numero((uint64_t)weight, weight_width).texto("\n");
+    });
+    out.texto(";\n\nset E := \n");
+    vector<pair<uint32_t, uint32_t>> edges;
+    for (size_t row = 0; row < n; ++row) {
+        gerador.linha(row, edges);
+        if (edges.empty()) continue;
+        for (const pair<uint32_t, uint32_t>& edge : edges) {
+            out.texto(" (").numero(min(edge.first, edge.second) + 1).texto(",").numero(max(edge.first, edge.second) + 1).texto(")");
+        }
+        out.texto("\n");
+    }
+    out.texto(";\n\nend;\n");
+    if (!out.fecha()) {
+        cerr << "Erro ao gravar o arquivo da instância: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+// CSR no formato de Loader.hpp. Os graus saem de uma primeira passada pelas
+// arestas; os vizinhos são montados por faixas de vértices que cabem no buffer,
+// gerando as arestas de novo para cada faixa
+bool escreve_binario_gerado(const Gerador& gerador, const GeneratorConfig& config, const string& path) {
+    const size_t n = gerador.size();
+    vector<pair<uint32_t, uint32_t>> edges;
+    vector<uint64_t> offsets(n + 1, 0);
+    for (size_t row = 0; row < n; ++row) {
+        gerador.linha(row, edges);
+        for (const pair<uint32_t, uint32_t>& edge : edges) {
+            offsets[edge.first + 1]++;
+            offsets[edge.second + 1]++;
+        }
+    }
+    for (size_t v = 0; v < n; ++v) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    Saida out(path);
+    if (!out.ok()) {
+        cerr << "Erro ao criar o arquivo da instância: " << path << "\n";
+        return false;
+    }
+    BinaryHeader header;
+    memcpy(header.magic, "TDGRAFOB", sizeof(header.magic));
+    header.version = BINARY_VERSION;
+    header.byte_order = BINARY_BYTE_ORDER;
+    header.num_clusters = num_clusters(config);
+    header.num_vertices = n;
+    header.num_arcs = offsets[n];
+    out.bytes(&header, sizeof(header));
+    out.bytes(offsets.data(), offsets.size() * sizeof(uint64_t));
+    for (uint64_t id = 1; id <= n; ++id) {
+        out.bytes(&id, sizeof(id));
+    }
+    gerador.pesos([&](size_t, float weight) { out.bytes(&weight, sizeof(weight)); });
+    const char padding[8] = {};
+    out.bytes(padding, (8 - n * sizeof(float) % 8) % 8);
+
+    const size_t budget = max<size_t>(config.memory_mb, 1) * (1 << 20) / sizeof(uint32_t);
+    vector<uint32_t> targets;
+    vector<uint64_t> cursor;
+    for (size_t first = 0; first < n; ) {
+        size_t last = first + 1;
+        while (last < n && offsets[last + 1] - offsets[first] <= budget) ++last;
+        targets.resize(offsets[last] - offsets[first]);
+        cursor.assign(offsets.begin() + first, offsets.begin() + last);
+        for (size_t row = 0; row < n; ++row) {
+            gerador.linha(row, edges);
+            for (const pair<uint32_t, uint32_t>& edge : edges) {
+                if (edge.first >= first && edge.first < last) {
+                    targets[cursor[edge.first - first]++ - offsets[first]] = edge.second;
+                }
+                if (edge.second >= first && edge.second < last) {
+                    targets[cursor[edge.second - first]++ - offsets[first]] = edge.first;
+                }
+            }
+        }
+        // Vizinhos em ordem crescente, como a CSR montada pelo Loader
+        for (size_t v = first; v < last; ++v) {
+            sort(targets.begin() + (offsets[v] - offsets[first]), targets.begin() + (offsets[v + 1] - offsets[first]));
+        }
+        out.bytes(targets.data(), targets.size() * sizeof(uint32_t));
+        first = last;
+    }
+    if (!out.fecha()) {
+        cerr << "Erro ao gravar o arquivo da instância: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+void mostra_uso(const char* program) {
+    cerr << "Uso: " << program << " --gera [opções] <arquivo|diretório>\n"
+         << "  --vertices n         número de vértices (padrão: 1000)\n"
+         << "  --familia f          d03, d06 ou pla (padrão: d03)\n"
+         << "  --densidade x        famílias d: probabilidade de cada aresta (padrão: 1/3 em d03, 2/3 em d06)\n"
+         << "  --grau g             grau médio; nas famílias d no lugar da densidade, em pla até 6 (padrão: 5.7)\n"
+         << "  --clusters p         p1 = ln n, p2 = raiz de n, p3 = n / ln n ou um número (padrão: p2)\n"
+         << "  --pesos d            uniforme, exponencial ou loguniforme (padrão: uniforme)\n"
+         << "  --peso-max w         pesos inteiros em [1, w] (padrão: n)\n"
+         << "  --semente s          (padrão: 1)\n"
+         << "  --binario            grava no formato binário (.bin)\n"
+         << "  --memoria MB         buffer das adjacências no formato binário (padrão: 1024)\n"
+         << "Com um diretório, o arquivo recebe o nome no padrão das instâncias (por exemplo n1000d03p2i1.txt).\n";
+}
+
+bool le_opcoes(int argc, char* argv[], GeneratorConfig& config, string& output) {
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--binario") {
+            config.binary = true;
+            continue;
+        }
+        if (arg.compare(0, 2, "--") != 0) {
+            if (!output.empty()) {
+                cerr << "Mais de um arquivo de saída: " << arg << "\n";
+                return false;
+            }
+            output = arg;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Opção sem valor: " << arg << "\n";
+            return false;
+        }
+        string value = argv[++i];
+        bool valid = true;
+        if (arg == "--vertices") {
+            valid = le_numero(value, config.num_vertices);
+        } else if (arg == "--familia") {
+            config.family = value;
+        } else if (arg == "--densidade") {
+            valid = le_numero(value, config.density);
+        } else if (arg == "--grau") {
+            valid = le_numero(value, config.degree);
+        } else if (arg == "--clusters") {
+            config.clusters = value;
+        } else if (arg == "--pesos") {
+            config.weights = value;
+        } else if (arg == "--peso-max") {
+            valid = le_numero(value, config.max_weight);
+        } else if (arg == "--semente") {
+            valid = le_numero(value, config.seed);
+        } else if (arg == "--memoria") {
+            valid = le_numero(value, config.memory_mb);
+        } else {
+            cerr << "Opção desconhecida: " << arg << "\n";
+            return false;
+        }
+        if (!valid) {
+            cerr << "Valor inválido para " << arg << ": " << value << "\n";
+            return false;
+        }
+    }
+    return !output.empty();
+}
+
+} // namespace
+
+string nome_instancia(const GeneratorConfig& config) {
+    ostringstream name;
+    name << 'n' << config.num_vertices << config.family;
+    // Parâmetros fora do padrão da família entram no nome para não colidirem
+    if (config.density >= 0) name << "-d" << config.density;
+    if (config.degree > 0) name << "-g" << config.degree;
+    if (config.weights != "uniforme") name << '-' << config.weights;
+    if (config.max_weight > 0) name << "-w" << config.max_weight;
+    const bool named = config.clusters == "p1" || config.clusters == "p2" || config.clusters == "p3";
+    name << (named ? config.clusters : "c" + config.clusters) << 'i' << config.seed << (config.binary ? ".bin" : ".txt");
+    return name.str();
+}
+
+bool gera_instancia(const GeneratorConfig& config, const string& path) {
+    string erro;
+    if (!valida(config, erro)) {
+        cerr << "Erro: " << erro << "\n";
+        return false;
+    }
+    Gerador gerador(config);
+    return config.binary ? escreve_binario_gerado(gerador, config, path) : escreve_texto(gerador, config, path);
+}
+
+int executa_gerador(int argc, char* argv[]) {
+    GeneratorConfig config;
+    string output;
+    if (!le_opcoes(argc, argv, config, output)) {
+        mostra_uso(argv[0]);
+        return 1;
+    }
+    error_code error;
+    if (filesystem::is_directory(output, error)) {
+        output = (filesystem::path(output) / nome_instancia(config)).string();
+    }
+    if (!gera_instancia(config, output)) {
+        return 1;
+    }
+    cout << "Instância gerada: " << output << "\n";
+    return 0;
+}
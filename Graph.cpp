@@ -1,109 +1,117 @@
 #include "include/Graph.hpp"
+#include "include/Checkpoint.hpp"
+#include "include/ElitePool.hpp"
+#include "include/Instrument.hpp"
+#include "include/Loader.hpp"
+#include "include/LocalSearch.hpp"
+#include "include/MappedFile.hpp"
+#include "include/Partition.hpp"
+#include "include/Random.hpp"
+#include "include/TabuSearch.hpp"
+#include "include/ThreadPool.hpp"
+#include "include/Validator.hpp"
 #include "include/defines.hpp"
 
 using namespace std;
 
-// Construtor que lê o arquivo e constrói o grafo
-Graph::Graph(ifstream& instance) : _first(nullptr) {
-    string line;
-    while (getline(instance, line)) {
-        if (line.find("param p") != string::npos) {
-            // Ignora "param p :=" e lê o número diretamente
-            istringstream param_stream(line);
-            string ignore;
-            param_stream >> ignore >> ignore >> ignore >> _num_clusters;
-            break; 
-        }
-    }
+typedef chrono::steady_clock Clock;
 
-    // Ler vérticesqlq 
-    getline(instance, line); 
-    getline(instance, line); 
-    while (getline(instance, line) && line.find(';') == string::npos) {
-        istringstream vertex_stream(line);
-        size_t node_id;
-        while (vertex_stream >> node_id) {
-            add_node(node_id, 0.0f); 
-        }
-    }
+static double segundos_desde(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
 
-    // Ler pesos dos vértices
-    getline(instance, line); 
-    getline(instance, line); 
-    while (getline(instance, line) && line.find(';') == string::npos) {
-        istringstream weight_stream(line);
-        size_t node_id;
-        float weight;
-        if (weight_stream >> node_id >> weight) {
-            add_node(node_id, weight); 
-        }
-    }
+static Solution falha(const string& motivo, uint64_t seed) {
+    Solution solution;
+    solution.erro = motivo;
+    solution.semente = seed;
+    return solution;
+}
 
-    // Ler arestas
-    // Aqui estava o problema, grafo nao direcionado precisa de aresta para cada direção
-    getline(instance, line); 
-    getline(instance, line); 
-    while (getline(instance, line) && line.find(';') == string::npos) {
-        stringstream ss(line);
-        char ignore;
-        size_t node_id_1, node_id_2;
+// Construtor que lê o arquivo e constrói o grafo
+Graph::Graph(ifstream& instance)
+    : _num_clusters(0), _number_of_nodes(0), _number_of_edges(0), _first(nullptr), _last(nullptr),
+      _lists_valid(true), _csr_valid(false), _bound_p(0) {
+    string buffer((istreambuf_iterator<char>(instance)), istreambuf_iterator<char>());
+    carrega(buffer.data(), buffer.size(), nullptr);
+}
 
-        while (ss >> ignore >> node_id_1 >> ignore >> node_id_2 >> ignore) {
-            add_edge(node_id_1, node_id_2, 0.0f); 
-            add_edge(node_id_2, node_id_1, 0.0f); 
-        }
+// Construtor que mapeia o arquivo em memória e lê direto do mapeamento
+Graph::Graph(const string& path)
+    : _num_clusters(0), _number_of_nodes(0), _number_of_edges(0), _first(nullptr), _last(nullptr),
+      _lists_valid(true), _csr_valid(false), _bound_p(0) {
+    shared_ptr<MappedFile> file = make_shared<MappedFile>(path);
+    if (!file->is_open()) {
+        cerr << "Erro ao mapear o arquivo de entrada: " << path << "\n";
+        return;
     }
+    carrega(file->data(), file->size(), file);
 }
 
-Graph::Graph() : _first(nullptr) {}
-
-Graph::~Graph() {
-    Node* current_node = _first;
-    while (current_node) {
-        Node* next_node = current_node->_next_node;
-        Edge* current_edge = current_node->_first_edge;
-        while (current_edge) {
-            Edge* next_edge = current_edge->_next_edge;
-            delete current_edge;
-            current_edge = next_edge;
-        }
-        delete current_node;
-        current_node = next_node;
+// A leitura monta só a CSR; as listas encadeadas são criadas quando a API de ponteiros for usada.
+// Arquivos no formato binário são usados no lugar, sem cópia.
+void Graph::carrega(const char* data, size_t size, const shared_ptr<MappedFile>& file) {
+    bool ok = file && eh_binario(data, size) ? carrega_binario(file, _csr, _num_clusters)
+                                             : carrega_instancia(data, size, _csr, _num_clusters);
+    if (!ok) {
+        cerr << "Erro: instância mal formatada." << endl;
+        _csr.storage = CSR::Storage();
+        _csr.storage.offsets.assign(1, 0);
+        _csr.attach_storage();
     }
+    _number_of_nodes = _csr.size();
+    _number_of_edges = _csr.num_arcs;
+    _csr_valid = true;
+    _bound_p = 0;
+    _lists_valid = false;
+}
+
+Graph::Graph()
+    : _num_clusters(0), _number_of_nodes(0), _number_of_edges(0), _first(nullptr), _last(nullptr),
+      _lists_valid(true), _csr_valid(false), _bound_p(0) {}
+
+// Nós e arestas vivem nos pools, que liberam seus blocos de uma vez
+Graph::~Graph() {}
+
+AllocationStats Graph::alocacoes() const {
+    AllocationStats stats;
+    stats.nos = _node_pool.live();
+    stats.arestas = _edge_pool.live();
+    stats.pedidos = _node_pool.allocations() + _edge_pool.allocations();
+    stats.blocos = _node_pool.blocks() + _edge_pool.blocks();
+    return stats;
 }
 
 void Graph::add_node(size_t node_id, float weight) {
-    Node* current = _first;
-    while (current) {
-        if (current->_id == node_id) {
-            current->_weight = weight;
-            return;
-        }
-        current = current->_next_node;
+    materializa_listas();
+    Node* current = _index.find(node_id);
+    if (current) {
+        current->_weight = weight;
+        _csr_valid = false;
+        return;
     }
-    Node* new_node = new Node;
+    Node* new_node = _node_pool.allocate();
+    new_node->_number_of_edges = 0;
     new_node->_id = node_id;
     new_node->_weight = weight;
+    new_node->_index = 0;
     new_node->_first_edge = nullptr;
     new_node->_next_node = _first;
     new_node->_previous_node = nullptr;
 
     if (_first) {
         _first->_previous_node = new_node;
+    } else {
+        _last = new_node;
     }
     _first = new_node;
+    _index.insert(node_id, new_node);
     _number_of_nodes++;
+    _csr_valid = false;
 }
 
 void Graph::add_edge(size_t node_id_1, size_t node_id_2, float weight) {
-    Node* node1 = _first;
-    while (node1 && node1->_id != node_id_1) {
-        node1 = node1->_next_node;
-    }
-    Node* node2 = _first;
-    while (node2 && node2->_id != node_id_2) {
-        node2 = node2->_next_node;
-    }
+    Node* node1 = find_node(node_id_1);
+    Node* node2 = find_node(node_id_2);
 
     if (node1 && node2) {
         Edge* edge = node1->_first_edge;
@@ -114,15 +122,183 @@ void Graph::add_edge(size_t node_id_1, size_t node_id_2, float weight) {
             edge = edge->_next_edge;
         }
 
-        Edge* new_edge = new Edge;
+        Edge* new_edge = _edge_pool.allocate();
         new_edge->_target_id = node_id_2;
         new_edge->_weight = weight;
         new_edge->_next_edge = node1->_first_edge;
         node1->_first_edge = new_edge;
+        node1->_number_of_edges++;
+        _number_of_edges++;
+        _csr_valid = false;
+    }
+}
+
+// Remove o vértice, suas arestas e todas as arestas que chegam nele
+void Graph::remove_node(size_t node_id) {
+    Node* node = find_node(node_id);
+    if (!node) return;
+
+    for (Node* other = _first; other; other = other->_next_node) {
+        if (other != node) {
+            remove_edge(other->_id, node_id);
+        }
+    }
+
+    Edge* edge = node->_first_edge;
+    while (edge) {
+        Edge* next_edge = edge->_next_edge;
+        _edge_pool.release(edge);
+        _number_of_edges--;
+        edge = next_edge;
+    }
+
+    if (node->_previous_node) {
+        node->_previous_node->_next_node = node->_next_node;
+    } else {
+        _first = node->_next_node;
+    }
+    if (node->_next_node) {
+        node->_next_node->_previous_node = node->_previous_node;
+    } else {
+        _last = node->_previous_node;
+    }
+
+    _index.erase(node_id);
+    _node_pool.release(node);
+    _number_of_nodes--;
+    _csr_valid = false;
+}
+
+// Remove a aresta node_id_1 -> node_id_2 (o sentido inverso é outra aresta, como em add_edge)
+void Graph::remove_edge(size_t node_id_1, size_t node_id_2) {
+    Node* node = find_node(node_id_1);
+    if (!node) return;
+
+    Edge** link = &node->_first_edge;
+    while (*link) {
+        if ((*link)->_target_id == node_id_2) {
+            Edge* edge = *link;
+            *link = edge->_next_edge;
+            _edge_pool.release(edge);
+            node->_number_of_edges--;
+            _number_of_edges--;
+            _csr_valid = false;
+            return;
+        }
+        link = &(*link)->_next_edge;
+    }
+}
+
+// Cria os nós e arestas da visão por ponteiros a partir da CSR carregada
+void Graph::materializa_listas() {
+    if (_lists_valid) return;
+    _lists_valid = true;
+    _node_pool.reserve(_csr.size());
+    _edge_pool.reserve(_csr.num_arcs);
+    for (size_t v = 0; v < _csr.size(); ++v) {
+        Node* node = _node_pool.allocate();
+        node->_number_of_edges = _csr.degree(v);
+        node->_id = _csr.ids[v];
+        node->_weight = _csr.weights[v];
+        node->_index = v;
+        node->_first_edge = nullptr;
+        node->_next_node = _first;
+        node->_previous_node = nullptr;
+        for (const uint32_t* neighbor = _csr.end(v); neighbor != _csr.begin(v); ) {
+            --neighbor;
+            Edge* edge = _edge_pool.allocate();
+            edge->_target_id = _csr.ids[*neighbor];
+            edge->_weight = 0.0f;
+            edge->_next_edge = node->_first_edge;
+            node->_first_edge = edge;
+        }
+
+        if (_first) {
+            _first->_previous_node = node;
+        } else {
+            _last = node;
+        }
+        _first = node;
+        _index.insert(node->_id, node);
+    }
+}
+
+const LowerBound& Graph::limite_inferior(size_t p) {
+    const CSR& g = csr();
+    if (_bound_p != p) {
+        _bound = calcula_limite_inferior(g, p);
+        _bound_p = p;
+    }
+    return _bound;
+}
+
+const WeightOrder& Graph::ordem_por_peso() {
+    const CSR& g = csr();
+    if (_ordem.size() != g.size()) {
+        _ordem = WeightOrder(g);
+    }
+    return _ordem;
+}
+
+bool Graph::salva_binario(const string& path) {
+    return escreve_binario(csr(), _num_clusters, path);
+}
+
+void Graph::prepara(size_t p) {
+    csr();
+    limite_inferior(p);
+    ordem_por_peso();
+}
+
+PhaseTimes Graph::tempos() const {
+    lock_guard<mutex> lock(_tempos_mutex);
+    return _tempos;
+}
+
+void Graph::registra_tempos(const PhaseTimes& tempos) {
+    lock_guard<mutex> lock(_tempos_mutex);
+    _tempos = tempos;
+}
+
+const CSR& Graph::csr() {
+    if (!_csr_valid) {
+        build_csr();
     }
+    return _csr;
+}
+
+// Monta a CSR a partir das listas encadeadas, na ordem de inserção dos vértices
+void Graph::build_csr() {
+    CSR::Storage& storage = _csr.storage;
+    storage.offsets.assign(1, 0);
+    storage.targets.clear();
+    storage.weights.clear();
+    storage.ids.clear();
+    storage.offsets.reserve(_number_of_nodes + 1);
+    storage.weights.reserve(_number_of_nodes);
+    storage.ids.reserve(_number_of_nodes);
+
+    for (Node* node = _last; node; node = node->_previous_node) {
+        node->_index = storage.ids.size();
+        storage.ids.push_back(node->_id);
+        storage.weights.push_back(node->_weight);
+    }
+
+    storage.targets.reserve(_number_of_edges);
+    for (Node* node = _last; node; node = node->_previous_node) {
+        for (Edge* edge = node->_first_edge; edge; edge = edge->_next_edge) {
+            storage.targets.push_back(find_node(edge->_target_id)->_index);
+        }
+        storage.offsets.push_back(storage.targets.size());
+    }
+    _csr.attach_storage();
+    _csr_valid = true;
+    _bound_p = 0;
+    _ordem = WeightOrder();
 }
 
 void Graph::print_graph() {
+    materializa_listas();
     Node* node = _first;
     while (node) {
         cout << "Vertice: " << node->_id << " Peso: " << node->_weight << "\n";
@@ -138,67 +314,51 @@ void Graph::print_graph() {
 
 int Graph::conected(size_t node_id_1, size_t node_id_2) {
     if (node_id_1 == node_id_2) return 1; 
-    Node* start_node = _first;
-    while (start_node && start_node->_id != node_id_1) {
-        start_node = start_node->_next_node;
-    }
-    Node* end_node = _first;
-    while (end_node && end_node->_id != node_id_2) {
-        end_node = end_node->_next_node;
-    }
+    Node* start_node = find_node(node_id_1);
+    Node* end_node = find_node(node_id_2);
 
     if (!start_node || !end_node) {
         cerr << "Erro: Um ou ambos os vértices não existem no grafo." << endl;
         return 0; 
     }
 
-    //busca em profundidade para verificar conectividade
-    stack<size_t> s;
-    unordered_set<size_t> visited;
-    s.push(node_id_1);
-    visited.insert(node_id_1);
+    csr();
+    vector<char> visited;
+    return conectado(start_node->_index, end_node->_index, visited) ? 1 : 0;
+}
 
-    while (!s.empty()) {
-        size_t current_node_id = s.top();
-        s.pop();
+// Busca em profundidade sobre a CSR, usando índices densos
+bool Graph::conectado(size_t index_1, size_t index_2, vector<char>& visited) {
+    if (index_1 == index_2) return true;
+    const CSR& g = _csr;
+    visited.assign(g.size(), 0);
 
-        Node* current_node = _first;
-        while (current_node && current_node->_id != current_node_id) {
-            current_node = current_node->_next_node;
-        }
+    vector<uint32_t> s;
+    s.push_back(index_1);
+    visited[index_1] = 1;
 
-        if (!current_node) {
-            cerr << "Erro: Vértice " << current_node_id << " não encontrado." << endl;
-            return 0;
-        }
+    while (!s.empty()) {
+        uint32_t current = s.back();
+        s.pop_back();
 
-        Edge* edge = current_node->_first_edge;
-        while (edge) {
-            size_t neighbor_id = edge->_target_id;
-            if (neighbor_id == node_id_2) {
-                return 1; // Encontrou o nó alvo
+        for (const uint32_t* neighbor = g.begin(current); neighbor != g.end(current); ++neighbor) {
+            if (*neighbor == index_2) {
+                return true; // Encontrou o nó alvo
             }
-            if (visited.find(neighbor_id) == visited.end()) {
-                s.push(neighbor_id);
-                visited.insert(neighbor_id);
+            if (!visited[*neighbor]) {
+                visited[*neighbor] = 1;
+                s.push_back(*neighbor);
             }
-            edge = edge->_next_edge;
         }
     }
 
-    return 0;
+    return false;
 }
 
 
 Node* Graph::find_node(size_t id) {
-    Node* current = _first;
-    while (current) {
-        if (current->_id == id) {
-            return current;
-        }
-        current = current->_next_node;
-    }
-    return nullptr; // Nó não encontrado
+    materializa_listas();
+    return _index.find(id); // nullptr se o nó não existir
 }
 
 
@@ -211,119 +371,184 @@ float Graph::gap(const Subgraph& subgraph) {
 }
 
 
-/// GULOSO
-float Graph::guloso(size_t p) {
-    if (p > _number_of_nodes) {
-        cerr << "Número de clusters não pode ser maior que o número de vértices.\n";
-        return -1;
+// Preenche o subgrafo (ids, pesos e limites) a partir dos índices densos dos seus vértices
+void Graph::monta_subgrafo(const vector<uint32_t>& members, Subgraph& subgraph) {
+    const CSR& g = _csr;
+    subgraph.vertices.clear();
+    subgraph.vertices.reserve(members.size());
+    subgraph.max_weight = numeric_limits<float>::lowest();
+    subgraph.min_weight = numeric_limits<float>::max();
+    subgraph.total_weight = 0.0f;
+    for (uint32_t v : members) {
+        subgraph.vertices.push_back(g.ids[v]);
+        subgraph.total_weight += g.weights[v];
+        subgraph.max_weight = max(subgraph.max_weight, g.weights[v]);
+        subgraph.min_weight = min(subgraph.min_weight, g.weights[v]);
     }
+}
+
 
-    // Criar um vetor para armazenar os subgrafos
-    vector<Subgraph> subgraphs(p);
-    for (auto& subgraph : subgraphs) {
-        subgraph.max_weight = numeric_limits<float>::min();
-        subgraph.min_weight = numeric_limits<float>::max();
-        subgraph.total_weight = 0.0f;
+// Gaps por subgrafo e total a partir dos subgrafos já montados
+void Graph::calcula_gaps(Solution& solution) {
+    solution.gaps.resize(solution.subgraphs.size());
+    solution.total_gap = 0;
+    for (size_t i = 0; i < solution.subgraphs.size(); ++i) {
+        float subgraph_gap = gap(solution.subgraphs[i]);
+        if (isnan(subgraph_gap) || isinf(subgraph_gap)) {
+            solution.erro = "Gap inválido calculado para o subgrafo " + to_string(i + 1) + ".";
+            solution.total_gap = -1;
+            return;
+        }
+        solution.gaps[i] = subgraph_gap;
+        solution.total_gap += subgraph_gap;
     }
+}
 
-    // Usar um conjunto para acompanhar quais nós foram visitados
-    unordered_set<size_t> visited;
-    vector<Node*> nodes;
 
-    // Coletar todos os nós
-    Node* current = _first;
-    while (current) {
-        nodes.push_back(current);
-        current = current->_next_node;
+/// GULOSO
+// Completa uma partição de clusters conexos: um cluster vazio começa num vértice
+// livre com vizinho livre, os com menos de dois vértices crescem pela fronteira e
+// o resto entra pelo repair(). Retorna false se não der uma partição de todos os
+// vértices com pelo menos dois por cluster.
+static bool completa_particao(Partition& partition, size_t n) {
+    INSTRUMENT_PHASE("reparo");
+    uint32_t scan = 0;
+    for (uint32_t c = 0; c < partition.num_clusters(); ++c) {
+        if (partition.members(c).empty()) {
+            while (scan < n && (partition.assigned(scan) || !partition.has_free_neighbor(scan))) ++scan;
+            if (scan == n) return false;
+            partition.assign(scan, c);
+        }
+        uint32_t extra;
+        while (partition.members(c).size() < 2 && (extra = partition.next_frontier(c)) != Partition::NONE) {
+            partition.assign(extra, c);
+        }
     }
+    partition.repair();
+    for (uint32_t c = 0; c < partition.num_clusters(); ++c) {
+        if (partition.members(c).size() < 2) return false;
+    }
+    return partition.num_assigned() == n;
+}
 
-    // Realizar DFS para criar subgrafos
-    size_t cluster_size = _number_of_nodes / p; 
-    for (size_t i = 0; i < p && !nodes.empty(); ++i) {
-        vector<size_t> vertices_in_subgraph;
-        stack<size_t> s;
-
-        size_t start_index = rand() % nodes.size();
-        while (visited.find(nodes[start_index]->_id) != visited.end()) {
-            start_index = (start_index + 1) % nodes.size(); 
+// Construção do guloso, também usada como ponto de partida da busca tabu:
+// subgrafos por DFS a partir de vértices sorteados, até n / p vértices cada.
+// O DFS pode deixar vértices de fora, e um subgrafo que não cresce fica com um
+// vértice só; o reparo completa a partição pela fronteira dos subgrafos. Se
+// nem assim der certo (grafos esparsos), recomeça de um par de vértices vizinhos
+// sorteado para cada subgrafo. clusters recebe os vértices de cada subgrafo,
+// em índices densos da CSR; retorna false se não achou uma partição válida.
+bool Graph::constroi_guloso(size_t p, uint64_t seed, vector<vector<uint32_t>>& clusters, PhaseTimes& tempos) {
+    INSTRUMENT_PHASE("construcao");
+    INSTRUMENT_COUNT(ITERACOES);
+    const CSR& g = _csr;
+    const size_t n = g.size();
+    Clock::time_point phase_start = Clock::now();
+
+    Partition partition(g, p);
+    size_t cluster_size = n / p;
+    vector<uint32_t> s;
+    Random rng(seed);
+    for (uint32_t i = 0; i < p && partition.num_assigned() < n; ++i) {
+        s.clear();
+
+        size_t start_index = rng.uniform(n);
+        while (partition.assigned(start_index)) {
+            start_index = (start_index + 1) % n;
         }
-        
-        s.push(nodes[start_index]->_id);
-        
+
+        s.push_back(start_index);
+        INSTRUMENT_COUNT(CANDIDATOS_INSERIDOS);
+
         // DFS para coletar vértices conexos
-        while (!s.empty() && vertices_in_subgraph.size() < cluster_size) {
-            size_t current_id = s.top();
-            s.pop();
+        while (!s.empty() && partition.members(i).size() < cluster_size) {
+            uint32_t current = s.back();
+            s.pop_back();
+            INSTRUMENT_COUNT(CANDIDATOS_REMOVIDOS);
 
-            if (visited.find(current_id) == visited.end()) {
-                visited.insert(current_id);
-                vertices_in_subgraph.push_back(current_id);
+            if (!partition.assigned(current)) {
+                partition.assign(current, i);
+                INSTRUMENT_COUNT(VISITAS_DFS);
 
                 // Adicionar arestas conectadas
-                Node* current_node = find_node(current_id);
-                Edge* edge = current_node->_first_edge;
-                while (edge) {
-                    if (visited.find(edge->_target_id) == visited.end()) {
-                        s.push(edge->_target_id);
+                for (const uint32_t* neighbor = g.begin(current); neighbor != g.end(current); ++neighbor) {
+                    if (!partition.assigned(*neighbor)) {
+                        s.push_back(*neighbor);
+                        INSTRUMENT_COUNT(CANDIDATOS_INSERIDOS);
                     }
-                    edge = edge->_next_edge;
                 }
             }
         }
+    }
 
-        // Verificar se o subgrafo tem pelo menos 2 vértices
-        if (vertices_in_subgraph.size() < 2 && i > 0) {
-            // Se o subgrafo for muito pequeno, mova vértices dos subgrafos anteriores
-            for (size_t j = 0; j < i; ++j) {
-                if (subgraphs[j].vertices.size() > 2) {
-                    vertices_in_subgraph.push_back(subgraphs[j].vertices.back());
-                    subgraphs[j].vertices.pop_back();
-                    break;
-                }
+    tempos.construcao = segundos_desde(phase_start);
+    phase_start = Clock::now();
+
+    bool valid = completa_particao(partition, n);
+    if (!valid) {
+        partition.reset(p);
+        for (uint32_t c = 0; c < p; ++c) {
+            size_t start_index = rng.uniform(n);
+            size_t probes = 0;
+            while (probes < n && (partition.assigned(start_index) || !partition.has_free_neighbor(start_index))) {
+                start_index = (start_index + 1) % n;
+                ++probes;
             }
+            if (probes == n) break;
+            partition.assign(start_index, c);
+            partition.assign(partition.next_frontier(c), c);
         }
+        valid = completa_particao(partition, n);
+    }
+    clusters.assign(p, vector<uint32_t>());
+    for (uint32_t c = 0; c < p && valid; ++c) {
+        clusters[c] = partition.members(c);
+    }
 
-        // Adicionar o subgrafo criado
-        Subgraph& current_subgraph = subgraphs[i];
-        current_subgraph.vertices = vertices_in_subgraph;
+    tempos.reparo = segundos_desde(phase_start);
+    return valid;
+}
 
-        // Atualizar pesos e limites
-        for (size_t vertex_id : vertices_in_subgraph) {
-            Node* node = find_node(vertex_id);
-            current_subgraph.total_weight += node->_weight;
-            current_subgraph.max_weight = max(current_subgraph.max_weight, node->_weight);
-            current_subgraph.min_weight = min(current_subgraph.min_weight, node->_weight);
-        }
+Solution Graph::guloso(size_t p, bool busca_local, uint64_t seed) {
+    const CSR& g = csr();
+    const size_t n = g.size();
+    if (p == 0 || p > n) {
+        return falha("O número de clusters deve estar entre 1 e o número de vértices.", seed);
     }
+    PhaseTimes tempos;
+    vector<vector<uint32_t>> clusters;
+    if (!constroi_guloso(p, seed, clusters, tempos)) {
+        return falha("A construção gulosa não achou " + to_string(p) + " subgrafos conexos com pelo menos dois vértices cobrindo o grafo.", seed);
+    }
+    Clock::time_point phase_start = Clock::now();
 
-    // Verificar se todos os subgrafos têm pelo menos 2 vértices
-    for (size_t i = 0; i < p; ++i) {
-        if (subgraphs[i].vertices.size() < 2) {
-            cerr << "Erro: Subgrafo " << i + 1 << " tem menos de 2 vértices. Corrigindo...\n";
-            // Mover vértices de outros subgrafos com mais de 2 vértices
-            for (size_t j = 0; j < p; ++j) {
-                if (subgraphs[j].vertices.size() > 2) {
-                    subgraphs[i].vertices.push_back(subgraphs[j].vertices.back());
-                    subgraphs[j].vertices.pop_back();
-                    break;
-                }
-            }
+    // Melhorar a partição construída com a busca local
+    if (busca_local) {
+        LocalSearch local_search(g);
+        local_search.load(clusters);
+        local_search.run();
+        for (size_t i = 0; i < p; ++i) {
+            clusters[i] = local_search.members(i);
         }
     }
-
-    // Calcular e imprimir o gap para cada subgrafo
-    float total_gap = 0;
+    tempos.busca_local = segundos_desde(phase_start);
+    phase_start = Clock::now();
+
+    Solution solution;
+    solution.semente = seed;
+    solution.subgraphs.resize(p);
+    if (limite_inferior(p).viavel) {
+        solution.limite_inferior = _bound.valor;
+    }
     for (size_t i = 0; i < p; ++i) {
-        float subgraph_gap = gap(subgraphs[i]);
-        cout << "Subgrafo " << (i + 1) << " (Vértices: ";
-        for (size_t vertex : subgraphs[i].vertices) {
-            cout << vertex << " ";
-        }
-        cout << ") - Gap: " << subgraph_gap << endl;
-        total_gap += subgraph_gap;
+        monta_subgrafo(clusters[i], solution.subgraphs[i]);
     }
-    cout << "Gap total calculado: " << total_gap << endl;
-    return total_gap;
+
+    // Calcular o gap de cada subgrafo
+    calcula_gaps(solution);
+    tempos.saida = segundos_desde(phase_start);
+    registra_tempos(tempos);
+    return solution;
 }
 
 
@@ -342,320 +567,767 @@ bool Graph::verifica_conexo(const vector<size_t>& vertices, size_t new_vertex) {
 
 
 /// GULOSO RANDOMIZADO ADAPTATIVO
-float Graph::guloso_randomizado_adaptativo(size_t p, float alpha) {
-    if (p > _number_of_nodes) {
-        cerr << "Número de clusters não pode ser maior que o número de vértices.\n";
-        return -1;
-    }
-
-    vector<Subgraph> subgraphs(p);
-    for (auto& subgraph : subgraphs) {
-        subgraph.max_weight = numeric_limits<float>::min();
-        subgraph.min_weight = numeric_limits<float>::max();
-        subgraph.total_weight = 0.0f;
-    }
 
-    unordered_set<size_t> visited;
-    vector<Node*> nodes;
+// Próximo vértice do subgrafo c, sorteado da RCL: os vértices livres da fronteira
+// cujo aumento no gap fica em [c_min, c_max] com c_max = c_min + alpha (maior
+// aumento - c_min). Como o aumento só depende da distância do peso à faixa
+// [menor, maior] do subgrafo, a RCL é um intervalo de postos na fronteira, e
+// sortear dela custa O(log n). Com alpha = 0 sai o vizinho de peso mais próximo.
+static uint32_t sorteia_da_rcl(const CSR& g, const Partition& partition, size_t c, const RankFrontier& frontier,
+                               float alpha, Random& rng) {
+    const float range_min = partition.min_weight(c);
+    const float range_max = partition.max_weight(c);
+    auto cost = [&](uint32_t v) {
+        return max(range_max, g.weights[v]) - min(range_min, g.weights[v]) - (range_max - range_min);
+    };
+    const uint32_t nearest = frontier.nearest(range_min, range_max);
+    const float cost_min = cost(nearest);
+    const float cost_max = max(cost(frontier.lightest()), cost(frontier.heaviest()));
+    const float threshold = cost_min + alpha * (cost_max - cost_min);
+
+    const pair<size_t, size_t> rcl = frontier.range(range_min - threshold, range_max + threshold);
+    return rcl.second > rcl.first ? frontier.at(rcl.first + rng.uniform(rcl.second - rcl.first)) : nearest;
+}
 
-    Node* current = _first;
-    while (current) {
-        nodes.push_back(current);
-        current = current->_next_node;
+Solution Graph::guloso_randomizado_adaptativo(size_t p, float alpha, bool busca_local, uint64_t seed) {
+    const CSR& g = csr();
+    const size_t n = g.size();
+    if (p == 0 || p > n) {
+        return falha("O número de clusters deve estar entre 1 e o número de vértices.", seed);
     }
 
-    size_t cluster_size = _number_of_nodes / p;
-
-    // Primeira fase: alocar vértices em subgrafos
-    for (size_t i = 0; i < p && !nodes.empty(); ++i) {
-        vector<size_t> vertices_in_subgraph;
-        size_t start_index = rand() % nodes.size();
-        while (visited.find(nodes[start_index]->_id) != visited.end()) {
-            start_index = (start_index + 1) % nodes.size();
-        }
+    PhaseTimes tempos;
+    Clock::time_point phase_start = Clock::now();
+    INSTRUMENT_PHASE_BEGIN(construcao, "construcao");
+    INSTRUMENT_COUNT(ITERACOES);
 
-        size_t start_vertex = nodes[start_index]->_id;
-        visited.insert(start_vertex);
-        vertices_in_subgraph.push_back(start_vertex);
+    Partition partition(g, p);
+    size_t cluster_size = n / p;
 
-        Node* start_node = find_node(start_vertex);
-        priority_queue<pair<float, size_t>> candidates;
+    // Fronteira do subgrafo em construção, indexada pelo posto do peso e reaproveitada entre os clusters
+    RankFrontier frontier(ordem_por_peso());
+    Random rng(seed);
 
-        // Inserir vértices conectados na fila de prioridades
-        for (Edge* edge = start_node->_first_edge; edge; edge = edge->_next_edge) {
-            if (visited.find(edge->_target_id) == visited.end()) {
-                Node* target_node = find_node(edge->_target_id);
-                candidates.push({ target_node->_weight, edge->_target_id });
+    // Primeira fase: alocar vértices em subgrafos
+    for (size_t i = 0; i < p && partition.num_assigned() < n; ++i) {
+        // Como no reativo, o ponto de partida precisa de um vizinho livre
+        size_t start_index = rng.uniform(n);
+        size_t first_free = n;
+        bool found = false;
+        for (size_t probes = 0; probes < n && !found; ++probes) {
+            if (!partition.assigned(start_index)) {
+                if (first_free == n) first_free = start_index;
+                found = partition.has_free_neighbor(start_index);
             }
+            if (!found) start_index = (start_index + 1) % n;
+        }
+        if (!found) {
+            start_index = first_free;
         }
 
-        // Expandir subgrafo até atingir o tamanho desejado ou até o máximo de candidatos
-        while (!candidates.empty() && vertices_in_subgraph.size() < cluster_size) {
-            auto [weight, candidate_id] = candidates.top();
-            candidates.pop();
-
-            if (visited.find(candidate_id) == visited.end()) {
-                visited.insert(candidate_id);
-                vertices_in_subgraph.push_back(candidate_id);
-
-                // Adicionar vértices conectados ao novo candidato na fila
-                Node* candidate_node = find_node(candidate_id);
-                for (Edge* edge = candidate_node->_first_edge; edge; edge = edge->_next_edge) {
-                    if (visited.find(edge->_target_id) == visited.end()) {
-                        Node* target_node = find_node(edge->_target_id);
-                        candidates.push({ target_node->_weight, edge->_target_id });
-                    }
+        uint32_t candidate = start_index;
+        frontier.clear();
+
+        // Expandir o subgrafo pela RCL em torno do vizinho livre de peso mais
+        // próximo da faixa [menor, maior] do subgrafo (o que menos aumenta o gap)
+        // até o tamanho desejado. A fronteira não tem repetições, ao contrário de
+        // um heap com um item por aresta.
+        while (candidate != RankFrontier::NONE) {
+            frontier.erase(candidate);
+            partition.assign(candidate, i);
+            for (const uint32_t* neighbor = g.begin(candidate); neighbor != g.end(candidate); ++neighbor) {
+                if (!partition.assigned(*neighbor)) {
+                    frontier.insert(*neighbor);
                 }
             }
+            if (partition.members(i).size() >= cluster_size || frontier.empty()) {
+                break;
+            }
+            candidate = sorteia_da_rcl(g, partition, i, frontier, alpha, rng);
         }
 
         // Verificar se o subgrafo contém pelo menos dois vértices
-        if (vertices_in_subgraph.size() < 2) {
-            cerr << "O subgrafo gerado contém menos de dois vértices. Ajustando...\n";
-            
-            // Procurar e adicionar vértices não visitados adjacentes
-            for (Node* extra_node : nodes) {
-                if (visited.find(extra_node->_id) == visited.end()) {
-                    if (verifica_conexo(vertices_in_subgraph, extra_node->_id)) {
-                        vertices_in_subgraph.push_back(extra_node->_id);
-                        visited.insert(extra_node->_id);
-
-                        if (vertices_in_subgraph.size() >= 2) {
-                            break;
-                        }
-                    }
-                }
+        if (partition.members(i).size() < 2) {
+            Clock::time_point repair_start = Clock::now();
+
+            // Adicionar vértices livres da fronteira do subgrafo
+            uint32_t extra;
+            while (partition.members(i).size() < 2 && (extra = partition.next_frontier(i)) != Partition::NONE) {
+                partition.assign(extra, i);
             }
 
             // Se ainda não temos dois vértices, houve uma falha no ajuste
-            if (vertices_in_subgraph.size() < 2) {
-                cerr << "Não foi possível encontrar vértices suficientes para o subgrafo.\n";
-                return -1;
+            if (partition.members(i).size() < 2) {
+                return falha("Não foi possível encontrar vértices suficientes para o subgrafo " + to_string(i + 1) + ".", seed);
             }
+            tempos.reparo += segundos_desde(repair_start);
         }
+    }
+    tempos.construcao = segundos_desde(phase_start) - tempos.reparo;
+    INSTRUMENT_PHASE_END(construcao);
+    phase_start = Clock::now();
+
+    // Segunda fase: alocar vértices restantes em subgrafos adjacentes, garantindo a
+    // conectividade, e completar os subgrafos que ficaram com menos de dois vértices
+    if (!completa_particao(partition, n)) {
+        return falha("Não foi possível completar a partição com subgrafos conexos de pelo menos dois vértices.", seed);
+    }
 
-        Subgraph& current_subgraph = subgraphs[i];
-        current_subgraph.vertices = vertices_in_subgraph;
+    tempos.reparo += segundos_desde(phase_start);
+    phase_start = Clock::now();
 
-        for (size_t vertex_id : vertices_in_subgraph) {
-            Node* node = find_node(vertex_id);
-            current_subgraph.total_weight += node->_weight;
-            current_subgraph.max_weight = max(current_subgraph.max_weight, node->_weight);
-            current_subgraph.min_weight = min(current_subgraph.min_weight, node->_weight);
+    Solution solution;
+    solution.semente = seed;
+    solution.subgraphs.resize(p);
+    if (limite_inferior(p).viavel) {
+        solution.limite_inferior = _bound.valor;
+    }
+    if (busca_local) {
+        // Melhorar a partição construída com a busca local
+        LocalSearch local_search(g);
+        local_search.load(partition);
+        local_search.run();
+        tempos.busca_local = segundos_desde(phase_start);
+        phase_start = Clock::now();
+        for (size_t i = 0; i < p; ++i) {
+            monta_subgrafo(local_search.members(i), solution.subgraphs[i]);
+        }
+    } else {
+        for (size_t i = 0; i < p; ++i) {
+            monta_subgrafo(partition.members(i), solution.subgraphs[i]);
         }
     }
 
-    // Segunda fase: alocar vértices restantes em subgrafos garantindo a conectividade
-    for (Node* node = _first; node; node = node->_next_node) {
-        if (visited.find(node->_id) == visited.end()) {
-            // Tentativa de adicionar o vértice a um subgrafo existente mantendo a conectividade
-            for (auto& subgraph : subgraphs) {
-                if (verifica_conexo(subgraph.vertices, node->_id)) {
-                    subgraph.vertices.push_back(node->_id);
-                    visited.insert(node->_id);
+    // Calcular o gap de cada subgrafo
+    calcula_gaps(solution);
+    tempos.saida = segundos_desde(phase_start);
+    registra_tempos(tempos);
+    return solution;
+}
 
-                    // Atualizar pesos e limites
-                    subgraph.total_weight += node->_weight;
-                    subgraph.max_weight = max(subgraph.max_weight, node->_weight);
-                    subgraph.min_weight = min(subgraph.min_weight, node->_weight);
-                    break; // Saia do loop ao adicionar o vértice
-                }
+
+
+/// GULOSO RANDOMIZADO ADAPTATIVO REATIVO 
+
+// Estado privado de cada worker do GRASP: gerador, buffers e melhor solução local
+struct GraspWorker {
+    Partition partition;
+    LocalSearch local_search;
+    RankFrontier frontier;
+    PathRelinker relinker;
+    Random rng;
+    vector<Subgraph> best_subgraphs;
+    float best_gap;
+    size_t best_iter;
+    vector<float> gaps_per_alpha;
+    vector<size_t> counts_per_alpha;
+    vector<IterationRecord> trace;
+    vector<EliteSolution> candidates; // para o pool de elite, oferecidas no fim do bloco
+    size_t executed;
+    PhaseTimes tempos;
+
+    GraspWorker(const CSR& g, const WeightOrder& order, size_t p, uint64_t seed, size_t worker, size_t num_alphas)
+        : partition(g, p), local_search(g), frontier(order), rng(Random(seed).split(worker)), best_gap(numeric_limits<float>::max()),
+          best_iter(numeric_limits<size_t>::max()), gaps_per_alpha(num_alphas, 0), counts_per_alpha(num_alphas, 0),
+          executed(0) {}
+};
+
+// Uma construção do GRASP reativo com o alpha sorteado (RCL em sorteia_da_rcl).
+// Retorna false se algum subgrafo ficou com menos de dois vértices ou se algum
+// vértice ficou fora de todos os subgrafos.
+bool Graph::constroi_reativo(size_t p, float alpha, GraspWorker& worker) {
+    INSTRUMENT_PHASE("construcao");
+    const CSR& g = _csr;
+    const size_t n = g.size();
+    Partition& partition = worker.partition;
+    RankFrontier& frontier = worker.frontier;
+    partition.reset(p);
+
+    size_t cluster_size = n / p;
+
+    for (size_t i = 0; i < p && partition.num_assigned() < n; ++i) {
+        // O ponto de partida precisa de um vizinho livre para o subgrafo chegar a
+        // dois vértices; se nenhum vértice livre tiver, fica o primeiro livre
+        size_t start_index = worker.rng.uniform(n);
+        size_t first_free = n;
+        bool found = false;
+        for (size_t probes = 0; probes < n && !found; ++probes) {
+            if (!partition.assigned(start_index)) {
+                if (first_free == n) first_free = start_index;
+                found = partition.has_free_neighbor(start_index);
             }
+            if (!found) start_index = (start_index + 1) % n;
+        }
+        if (!found) {
+            start_index = first_free;
         }
-    }
 
-    // Verificar novamente que todos os subgrafos têm pelo menos dois vértices
-    for (auto& subgraph : subgraphs) {
-        if (subgraph.vertices.size() < 2) {
-            cerr << "Ajustando subgrafo com menos de dois vértices na fase final.\n";
-            for (Node* extra_node : nodes) {
-                if (visited.find(extra_node->_id) == visited.end() && verifica_conexo(subgraph.vertices, extra_node->_id)) {
-                    subgraph.vertices.push_back(extra_node->_id);
-                    visited.insert(extra_node->_id);
-                    if (subgraph.vertices.size() >= 2) {
-                        break;
-                    }
+        uint32_t current = start_index;
+        frontier.clear();
+
+        while (current != RankFrontier::NONE) {
+            frontier.erase(current);
+            partition.assign(current, i);
+            for (const uint32_t* neighbor = g.begin(current); neighbor != g.end(current); ++neighbor) {
+                if (!partition.assigned(*neighbor)) {
+                    frontier.insert(*neighbor);
                 }
             }
-        }
-    }
+            if (partition.members(i).size() >= cluster_size || frontier.empty()) {
+                break;
+            }
 
-    // Calcular e imprimir o gap para cada subgrafo
-    float total_gap = 0;
-    for (size_t i = 0; i < p; ++i) {
-        float subgraph_gap = gap(subgraphs[i]);
-        cout << "Subgrafo " << (i + 1) << " (Vértices: ";
-        for (size_t vertex : subgraphs[i].vertices) {
-            cout << vertex << " ";
+            current = sorteia_da_rcl(g, partition, i, frontier, alpha, worker.rng);
         }
-        cout << ") - Gap: " << subgraph_gap << endl;
-        total_gap += subgraph_gap;
-    }
-    cout << "Gap total calculado: " << total_gap << endl;
-    return total_gap;
-}
 
+        // Verificação se o subgrafo contém pelo menos dois vértices
+        if (partition.members(i).size() < 2) {
+            Clock::time_point repair_start = Clock::now();
 
+            // Adicionar vértices livres da fronteira do subgrafo
+            uint32_t extra;
+            while (partition.members(i).size() < 2 && (extra = partition.next_frontier(i)) != Partition::NONE) {
+                partition.assign(extra, i);
+            }
+            worker.tempos.reparo += segundos_desde(repair_start);
 
-/// GULOSO RANDOMIZADO ADAPTATIVO REATIVO 
-float Graph::guloso_randomizado_adaptativo_reativo(size_t p, size_t max_iter) {
-    if (p > _number_of_nodes) {
-        cerr << "Número de clusters não pode ser maior que o número de vértices.\n";
-        return -1;
+            // Se ainda não temos dois vértices, a construção desta iteração é descartada
+            if (partition.members(i).size() < 2) {
+                return false;
+            }
+        }
     }
 
-    vector<Subgraph> best_subgraphs(p);
-    vector<float> alphas = {0.1f, 0.2f, 0.3f, 0.4f, 0.5f}; // Lista de alphas predefinidos
-    size_t iter = 0;
-    float total_gap = numeric_limits<float>::max();
-    vector<float> gaps_per_alpha(alphas.size(), 0);
-    vector<size_t> counts_per_alpha(alphas.size(), 0);
-    vector<float> performance(alphas.size(), numeric_limits<float>::max());
-
-    while (iter < max_iter) {
-        vector<Subgraph> subgraphs(p);
-        unordered_set<size_t> visited;
-        vector<Node*> nodes;
+    // Os vértices que nenhum subgrafo alcançou vão para um subgrafo adjacente
+    Clock::time_point repair_start = Clock::now();
+    const bool complete = completa_particao(partition, n);
+    worker.tempos.reparo += segundos_desde(repair_start);
+    return complete;
+}
 
-        Node* current = _first;
-        while (current) {
-            nodes.push_back(current);
-            current = current->_next_node;
+// O leitor do checkpoint só confere o enquadramento dos vetores; antes de retomar,
+// os rótulos do pool de elite e os subgrafos dos workers têm de caber no grafo,
+// senão o path-relinking e o casamento de partições indexariam fora dos vetores
+static bool checkpoint_consistente(const CSR& g, size_t p, const GraspCheckpoint& saved) {
+    for (const EliteSolution& member : saved.elite) {
+        if (member.label.size() != g.size()) {
+            return false;
         }
+        for (const uint32_t c : member.label) {
+            if (c >= p) return false;
+        }
+    }
+    vector<uint32_t> label;
+    for (const GraspWorkerState& worker : saved.workers) {
+        if (worker.best_subgraphs.empty()) continue;
+        Solution best;
+        best.subgraphs = worker.best_subgraphs;
+        if (best.subgraphs.size() != p || !rotulos_solucao(g, best, label).empty()) {
+            return false;
+        }
+    }
+    return true;
+}
 
-        size_t cluster_size = _number_of_nodes / p;
-
-        for (size_t i = 0; i < p && !nodes.empty(); ++i) {
-            vector<size_t> vertices_in_subgraph;
-            stack<size_t> s;
+// max_iter = 0 roda até o limite de tempo ou o gap alvo de config (pelo menos um
+// dos dois é obrigatório nesse caso). Em qualquer parada devolve o melhor encontrado.
+Solution Graph::guloso_randomizado_adaptativo_reativo(size_t p, size_t max_iter, const GraspConfig& config, AlphaStats* stats) {
+    const CSR& g = csr();
+    const size_t n = g.size();
+    if (p == 0 || p > n) {
+        return falha("O número de clusters deve estar entre 1 e o número de vértices.", config.seed);
+    }
+    if (max_iter == 0 && config.time_limit <= 0 && config.target_gap < 0) {
+        return falha("Sem critério de parada: informe iterações, limite de tempo ou gap alvo.", config.seed);
+    }
+    if (max_iter == 0) {
+        max_iter = numeric_limits<size_t>::max();
+    }
 
-            size_t start_index = rand() % nodes.size();
-            while (visited.find(nodes[start_index]->_id) != visited.end()) {
-                start_index = (start_index + 1) % nodes.size();
+    const WeightOrder& order = ordem_por_peso();
+    const vector<float>& alphas = config.alphas;
+    vector<float> gaps_per_alpha(alphas.size(), 0);
+    vector<size_t> counts_per_alpha(alphas.size(), 0);
+    vector<float> performance(alphas.size(), 1.0f);
+    vector<float> probabilities(alphas.size(), 1.0f / alphas.size());
+
+    // As iterações são independentes: dentro de um bloco de update_period iterações,
+    // cada worker roda as iterações w, w + T, w + 2T, ... com seu próprio gerador.
+    // O estado compartilhado durante o bloco é o gap incumbente, usado para evitar
+    // copiar soluções que já não podem vencer, e o sinal de parada (tempo ou alvo).
+    // No fim do bloco os workers se esperam e a junção é serial; com muitas threads
+    // o bloco cresce para que cada worker faça pelo menos block_per_thread iterações.
+    ThreadPool pool(max<size_t>(config.threads, 1));
+    const size_t threads = pool.size();
+    const size_t period = max<size_t>(max<size_t>(config.update_period, 1), config.block_per_thread * threads);
+    vector<GraspWorker> workers;
+    workers.reserve(threads);
+    for (size_t w = 0; w < threads; ++w) {
+        workers.emplace_back(g, order, p, config.seed, w, alphas.size());
+    }
+    atomic<float> incumbent(numeric_limits<float>::max());
+    atomic<bool> stop(false);
+    Clock::time_point start = Clock::now();
+    const size_t check_period = max<size_t>(config.check_period, 1);
+
+    // Parar também quando o incumbente alcança o limite inferior: não há como melhorar.
+    // A folga cobre arredondamento entre a soma em float dos gaps e o limite.
+    const LowerBound& bound = limite_inferior(p);
+    const float bound_gap = config.stop_at_bound && bound.viavel ? bound.valor * (1 + 1e-6f) + 1e-6f : -1.0f;
+    const float stop_gap = max(config.target_gap, bound_gap);
+
+    // Pool de elite para o path-relinking; a distância mínima é uma fração dos vértices
+    ElitePool elite(config.elite_size, (size_t)ceil(config.elite_diversity * n), p);
+    vector<EliteSolution> elite_candidates;
+
+    // Melhoras do incumbente, na ordem em que foram publicadas
+    mutex improvements_mutex;
+    float published = numeric_limits<float>::max();
+    vector<IncumbentRecord> improvements;
+
+    // Checkpoints: o estado no fim de um bloco basta para continuar como se a
+    // execução não tivesse parado, pois as probabilidades só mudam ali e os
+    // acumuladores dos workers estão zerados
+    size_t first_block = 0;
+    double previous_elapsed = 0;
+    unique_ptr<CheckpointWriter> checkpoint_writer;
+    Clock::time_point last_checkpoint = start;
+    if (!config.checkpoint.empty()) {
+        if (config.resume && ifstream(config.checkpoint)) {
+            GraspCheckpoint saved;
+            if (!le_checkpoint(config.checkpoint, saved)) {
+                return falha("Checkpoint inválido: " + config.checkpoint + ".", config.seed);
+            }
+            if (saved.num_vertices != n || saved.num_clusters != p || saved.threads != threads || saved.seed != config.seed ||
+                saved.update_period != period || saved.alphas != alphas || saved.workers.size() != threads ||
+                saved.elite_size != config.elite_size || saved.elite_diversity != config.elite_diversity) {
+                return falha("O checkpoint " + config.checkpoint + " é de outra execução (grafo, p, semente, threads, alphas, update_period ou pool de elite).", config.seed);
+            }
+            if (!checkpoint_consistente(g, p, saved)) {
+                return falha("Checkpoint inválido: " + config.checkpoint + ".", config.seed);
             }
+            // O último bloco de uma execução pode ter sido cortado por max_iter; dali só
+            // se retoma com o mesmo max_iter (e nada resta a fazer)
+            if (saved.next_block % period != 0 && saved.next_block != max_iter) {
+                return falha("O checkpoint " + config.checkpoint + " é o final de uma execução com " + to_string(saved.next_block) +
+                             " iterações, que não é múltiplo de update_period; só pode ser retomado com esse número de iterações.", config.seed);
+            }
+            first_block = saved.next_block;
+            previous_elapsed = saved.elapsed;
+            start -= chrono::duration_cast<Clock::duration>(chrono::duration<double>(saved.elapsed));
+            incumbent = saved.incumbent;
+            published = saved.published;
+            gaps_per_alpha = saved.gaps_per_alpha;
+            counts_per_alpha.assign(saved.counts_per_alpha.begin(), saved.counts_per_alpha.end());
+            probabilities = saved.probabilities;
+            improvements = move(saved.improvements);
+            elite.members() = move(saved.elite);
+            for (size_t w = 0; w < threads; ++w) {
+                GraspWorkerState& state = saved.workers[w];
+                GraspWorker& worker = workers[w];
+                worker.rng.restore(state.rng);
+                worker.best_gap = state.best_gap;
+                worker.best_iter = state.best_iter;
+                worker.executed = state.executed;
+                worker.best_subgraphs = move(state.best_subgraphs);
+                worker.trace = move(state.trace);
+            }
+            if (stop_gap >= 0 && saved.incumbent <= stop_gap) {
+                stop = true;
+            }
+        }
+        checkpoint_writer = make_unique<CheckpointWriter>(config.checkpoint);
+    }
+    auto salva_checkpoint = [&](size_t next_block) {
+        GraspCheckpoint checkpoint;
+        checkpoint.num_vertices = n;
+        checkpoint.num_clusters = p;
+        checkpoint.threads = threads;
+        checkpoint.seed = config.seed;
+        checkpoint.update_period = period;
+        checkpoint.alphas = alphas;
+        checkpoint.elite_size = config.elite_size;
+        checkpoint.elite_diversity = config.elite_diversity;
+        checkpoint.next_block = next_block;
+        checkpoint.elapsed = segundos_desde(start);
+        checkpoint.incumbent = incumbent.load();
+        checkpoint.published = published;
+        checkpoint.gaps_per_alpha = gaps_per_alpha;
+        checkpoint.counts_per_alpha.assign(counts_per_alpha.begin(), counts_per_alpha.end());
+        checkpoint.probabilities = probabilities;
+        checkpoint.improvements = improvements;
+        checkpoint.elite = elite.members();
+        checkpoint.workers.resize(threads);
+        for (size_t w = 0; w < threads; ++w) {
+            GraspWorkerState& state = checkpoint.workers[w];
+            const GraspWorker& worker = workers[w];
+            memcpy(state.rng, worker.rng.state(), sizeof(state.rng));
+            state.best_gap = worker.best_gap;
+            state.best_iter = worker.best_iter;
+            state.executed = worker.executed;
+            state.best_subgraphs = worker.best_subgraphs;
+            state.trace = worker.trace;
+        }
+        // Só a cópia é feita aqui; serializar e gravar ficam com a thread do CheckpointWriter
+        checkpoint_writer->write(move(checkpoint));
+    };
+
+    // A busca local e o path-relinking também param no prazo, senão uma iteração
+    // começada perto do fim estoura o limite pelo tempo de uma busca inteira
+    const Deadline deadline = config.time_limit > 0
+        ? start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(config.time_limit))
+        : Deadline::max();
+
+    size_t next_block = first_block;
+    for (size_t block = first_block; block < max_iter && !stop.load(); block += period) {
+        if (config.time_limit > 0 && segundos_desde(start) >= config.time_limit) {
+            break;
+        }
+        const size_t block_end = max_iter - block > period ? block + period : max_iter;
+
+        pool.run([&](size_t w) {
+            GraspWorker& worker = workers[w];
+            size_t since_check = 0;
+            for (size_t iter = block + w; iter < block_end; iter += threads) {
+                // O relógio só é consultado a cada check_period iterações do worker
+                if (stop.load(memory_order_relaxed)) {
+                    break;
+                }
+                if (config.time_limit > 0 && ++since_check >= check_period) {
+                    since_check = 0;
+                    if (segundos_desde(start) >= config.time_limit) {
+                        stop.store(true, memory_order_relaxed);
+                        break;
+                    }
+                }
+                worker.executed++;
+                INSTRUMENT_COUNT(ITERACOES);
+
+                // Sortear o alpha pela distribuição atual antes de construir
+                double u = worker.rng.real();
+                size_t alpha_index = 0;
+                while (alpha_index + 1 < alphas.size() && u >= probabilities[alpha_index]) {
+                    u -= probabilities[alpha_index];
+                    alpha_index++;
+                }
 
-            s.push(nodes[start_index]->_id);
-            
-            while (!s.empty() && vertices_in_subgraph.size() < cluster_size) {
-                size_t current_id = s.top();
-                s.pop();
+                Clock::time_point phase_start = Clock::now();
+                const double repair_before = worker.tempos.reparo;
+                bool built = constroi_reativo(p, alphas[alpha_index], worker);
+                worker.tempos.construcao += segundos_desde(phase_start) - (worker.tempos.reparo - repair_before);
+                if (!built) {
+                    continue;
+                }
 
-                if (visited.find(current_id) == visited.end()) {
-                    visited.insert(current_id);
-                    vertices_in_subgraph.push_back(current_id);
+                // Busca local sobre a construção; os clusters passam a ser os da busca local
+                phase_start = Clock::now();
+                LocalSearch& local_search = worker.local_search;
+                local_search.load(worker.partition);
+                if (config.local_search) {
+                    local_search.run(numeric_limits<size_t>::max(), deadline);
+                }
+                const float constructed_gap = local_search.total_gap();
+
+                // Path-relinking em direção a um membro do pool de elite, seguido de
+                // nova busca local a partir do melhor ponto do caminho. O pool não
+                // muda durante o bloco, então é lido sem lock.
+                if (!elite.empty()) {
+                    const EliteSolution& guide = elite.members()[worker.rng.uniform(elite.size())];
+                    worker.relinker.run(local_search, guide.label, deadline);
+                    if (config.local_search) {
+                        local_search.run(numeric_limits<size_t>::max(), deadline);
+                    }
+                }
+                if (config.time_limit > 0 && Clock::now() >= deadline) {
+                    stop.store(true, memory_order_relaxed);
+                }
+                float current_gap = local_search.total_gap();
+                worker.tempos.busca_local += segundos_desde(phase_start);
 
-                    vector<pair<size_t, float>> RCL;
-                    Node* current_node = find_node(current_id);
-                    Edge* edge = current_node->_first_edge;
+                const IterationRecord record = { iter, alphas[alpha_index], current_gap };
+                worker.trace.push_back(record);
+                if (config.on_iteration) {
+                    config.on_iteration(record, local_search);
+                }
+                if (elite.accepts(current_gap)) {
+                    worker.candidates.push_back(EliteSolution{ local_search.labels(), current_gap, iter });
+                }
 
-                    while (edge) {
-                        if (visited.find(edge->_target_id) == visited.end()) {
-                            Node* target_node = find_node(edge->_target_id);
-                            RCL.emplace_back(edge->_target_id, target_node->_weight);
-                        }
-                        edge = edge->_next_edge;
+                // Atualizar o desempenho do alpha pelo gap da construção com busca
+                // local, antes do path-relinking, que não depende do alpha
+                worker.gaps_per_alpha[alpha_index] += constructed_gap;
+                worker.counts_per_alpha[alpha_index]++;
+
+                // Empates ficam com a menor iteração, o que torna o resultado independente do escalonamento
+                if (current_gap < worker.best_gap && current_gap <= incumbent.load(memory_order_relaxed)) {
+                    worker.best_gap = current_gap;
+                    worker.best_iter = iter;
+                    worker.best_subgraphs.resize(p);
+                    for (size_t i = 0; i < p; ++i) {
+                        monta_subgrafo(local_search.members(i), worker.best_subgraphs[i]);
                     }
-
-                    float max_weight = -numeric_limits<float>::infinity();
-                    for (const auto& candidate : RCL) {
-                        max_weight = max(max_weight, candidate.second);
+                    float seen = incumbent.load(memory_order_relaxed);
+                    while (current_gap < seen && !incumbent.compare_exchange_weak(seen, current_gap, memory_order_relaxed)) {
                     }
 
-                    vector<pair<size_t, float>> filtered_RCL;
-                    for (const auto& candidate : RCL) {
-                        if (candidate.second >= max_weight * 0.1f) {
-                            filtered_RCL.push_back(candidate);
+                    // Publicar a melhora (as melhoras são raras; o lock não pesa)
+                    if (current_gap < seen) {
+                        lock_guard<mutex> lock(improvements_mutex);
+                        if (current_gap < published) {
+                            published = current_gap;
+                            const IncumbentRecord record = { iter, current_gap, segundos_desde(start) };
+                            improvements.push_back(record);
+                            if (config.on_incumbent) {
+                                config.on_incumbent(record);
+                            }
                         }
                     }
-
-                    if (!filtered_RCL.empty()) {
-                        size_t rcl_index = rand() % filtered_RCL.size();
-                        s.push(filtered_RCL[rcl_index].first);
+                    if (stop_gap >= 0 && current_gap <= stop_gap) {
+                        stop.store(true, memory_order_relaxed);
                     }
                 }
             }
+        });
 
-            Subgraph& current_subgraph = subgraphs[i];
-            current_subgraph.vertices = vertices_in_subgraph;
-
-            // Verificação se o subgrafo contém pelo menos dois vértices
-            if (current_subgraph.vertices.size() < 2) {
-                cerr << "O subgrafo gerado contém menos de dois vértices. Ajustando...\n";
-                
-                // Procurar e adicionar vértices não visitados adjacentes
-                for (Node* extra_node : nodes) {
-                    if (visited.find(extra_node->_id) == visited.end() && 
-                        verifica_conexo(current_subgraph.vertices, extra_node->_id)) {
-                        current_subgraph.vertices.push_back(extra_node->_id);
-                        visited.insert(extra_node->_id);
-                        if (current_subgraph.vertices.size() >= 2) {
-                            break;
-                        }
-                    }
-                }
-
-                // Se ainda não temos dois vértices, houve uma falha no ajuste
-                if (current_subgraph.vertices.size() < 2) {
-                    cerr << "Não foi possível encontrar vértices suficientes para o subgrafo.\n";
-                    return -1;
-                }
+        // Fim do bloco: oferecer as candidatas ao pool na ordem das iterações
+        elite_candidates.clear();
+        for (GraspWorker& worker : workers) {
+            for (EliteSolution& candidate : worker.candidates) {
+                elite_candidates.push_back(move(candidate));
             }
+            worker.candidates.clear();
+        }
+        sort(elite_candidates.begin(), elite_candidates.end(),
+             [](const EliteSolution& a, const EliteSolution& b) { return a.iteration < b.iteration; });
+        for (const EliteSolution& candidate : elite_candidates) {
+            elite.offer(candidate.label, candidate.gap, candidate.iteration);
+        }
 
-            for (size_t vertex_id : current_subgraph.vertices) {
-                Node* node = find_node(vertex_id);
-                current_subgraph.total_weight += node->_weight;
-                current_subgraph.max_weight = max(current_subgraph.max_weight, node->_weight);
-                current_subgraph.min_weight = min(current_subgraph.min_weight, node->_weight);
+        // Juntar as estatísticas dos workers (sempre na mesma ordem)
+        for (GraspWorker& worker : workers) {
+            for (size_t a = 0; a < alphas.size(); ++a) {
+                gaps_per_alpha[a] += worker.gaps_per_alpha[a];
+                counts_per_alpha[a] += worker.counts_per_alpha[a];
+                worker.gaps_per_alpha[a] = 0;
+                worker.counts_per_alpha[a] = 0;
             }
         }
 
-        float current_gap = 0;
-        cout << "Iteração " << iter + 1 << endl;
-        for (size_t i = 0; i < p; ++i) {
-            float subgraph_gap = gap(subgraphs[i]);
-            if (isnan(subgraph_gap) || isinf(subgraph_gap)) {
-                cerr << "Erro: gap inválido calculado para o subgrafo " << i + 1 << ".\n";
-                return -1;
+        // Recalcular as probabilidades: q_i = (melhor gap / gap médio com alpha_i)^delta.
+        // Alphas ainda não usados recebem q = 1, como se tivessem média igual ao incumbente.
+        const float best = incumbent.load();
+        if (best != numeric_limits<float>::max()) {
+            float sum = 0;
+            for (size_t a = 0; a < alphas.size(); ++a) {
+                performance[a] = 1.0f;
+                if (counts_per_alpha[a] > 0) {
+                    float average = gaps_per_alpha[a] / counts_per_alpha[a];
+                    performance[a] = average > 0 ? pow(best / average, config.amplification) : 1.0f;
+                }
+                sum += performance[a];
             }
-            current_gap += subgraph_gap;
-
-            cout << "Subgrafo " << (i + 1) << " (Vértices: ";
-            for (size_t vertex : subgraphs[i].vertices) {
-                cout << vertex << " ";
+            for (size_t a = 0; a < alphas.size(); ++a) {
+                probabilities[a] = performance[a] / sum;
             }
-            cout << ") - Gap: " << subgraph_gap << endl;
         }
-        cout << "Gap total: " << current_gap << endl;
-
-        // Atualizar o desempenho do alpha
-        size_t alpha_index = rand() % alphas.size();
-        gaps_per_alpha[alpha_index] += current_gap;
-        counts_per_alpha[alpha_index]++;
 
-        if (current_gap < total_gap) {
-            total_gap = current_gap;
-            best_subgraphs = subgraphs; 
+        // Um bloco interrompido (tempo ou alvo) não é gravado: suas iterações ficaram pela metade
+        next_block = block_end;
+        if (checkpoint_writer && !stop.load() && segundos_desde(last_checkpoint) >= config.checkpoint_interval) {
+            last_checkpoint = Clock::now();
+            salva_checkpoint(next_block);
         }
+    }
+    // O último checkpoint é o estado final: retomar dele devolve o mesmo resultado sem iterar
+    if (checkpoint_writer && !stop.load()) {
+        salva_checkpoint(next_block);
+    }
 
-        iter++;
+    // Tempos por fase somados entre os workers (tempo de CPU, não de relógio)
+    PhaseTimes tempos;
+    for (GraspWorker& worker : workers) {
+        tempos.construcao += worker.tempos.construcao;
+        tempos.reparo += worker.tempos.reparo;
+        tempos.busca_local += worker.tempos.busca_local;
     }
+    Clock::time_point output_start = Clock::now();
 
-    // Impressão dos melhores subgrafos encontrados
-    cout << "Melhores subgrafos encontrados:\n";
-    for (size_t i = 0; i < best_subgraphs.size(); ++i) {
-        cout << "Subgrafo " << (i + 1) << " (Vértices: ";
-        for (size_t vertex : best_subgraphs[i].vertices) {
-            cout << vertex << " ";
+    float total_gap = numeric_limits<float>::max();
+    size_t best_iter = numeric_limits<size_t>::max();
+    Solution solution;
+    solution.semente = config.seed;
+    if (bound.viavel) {
+        solution.limite_inferior = bound.valor;
+    }
+    solution.melhorias.swap(improvements);
+    solution.tempo_anterior = previous_elapsed;
+    size_t executed = 0;
+    for (GraspWorker& worker : workers) {
+        if (worker.best_gap < total_gap || (worker.best_gap == total_gap && worker.best_iter < best_iter)) {
+            total_gap = worker.best_gap;
+            best_iter = worker.best_iter;
+            solution.subgraphs.swap(worker.best_subgraphs);
         }
-        float subgraph_gap = gap(best_subgraphs[i]);
-        if (isnan(subgraph_gap) || isinf(subgraph_gap)) {
-            cerr << "Erro: gap inválido calculado para o subgrafo " << i + 1 << ".\n";
-            return -1;
+        solution.trace.insert(solution.trace.end(), worker.trace.begin(), worker.trace.end());
+        executed += worker.executed;
+    }
+    sort(solution.trace.begin(), solution.trace.end(),
+         [](const IterationRecord& a, const IterationRecord& b) { return a.iteracao < b.iteracao; });
+
+    if (stats) {
+        stats->alphas = alphas;
+        stats->probabilities = probabilities;
+        stats->counts = counts_per_alpha;
+        stats->iterations = executed;
+        stats->average_gap.assign(alphas.size(), 0.0f);
+        for (size_t a = 0; a < alphas.size(); ++a) {
+            if (counts_per_alpha[a] > 0) {
+                stats->average_gap[a] = gaps_per_alpha[a] / counts_per_alpha[a];
+            }
         }
-        cout << ") - Gap: " << subgraph_gap << endl;
     }
-    cout << "Gap total final: " << total_gap << endl;
 
-    return total_gap;
+    if (solution.subgraphs.empty()) {
+        solution.erro = "Nenhuma iteração produziu subgrafos com pelo menos dois vértices.";
+        return solution;
+    }
+    calcula_gaps(solution);
+    tempos.saida += segundos_desde(output_start);
+    registra_tempos(tempos);
+
+    return solution;
+}
+
+
+/// BUSCA TABU
+// Parte do guloso ou, se dada, de uma solução válida (por exemplo lida de um
+// arquivo de solução)
+Solution Graph::busca_tabu(size_t p, const TabuConfig& config, TabuStats* stats, const Solution* initial) {
+    const CSR& g = csr();
+    const size_t n = g.size();
+    if (p == 0 || p > n) {
+        return falha("O número de clusters deve estar entre 1 e o número de vértices.", config.seed);
+    }
+    if (config.max_iter == 0 && config.time_limit <= 0 && config.target_gap < 0) {
+        return falha("Sem critério de parada: informe iterações, limite de tempo ou gap alvo.", config.seed);
+    }
+    const LowerBound& bound = limite_inferior(p);
+    if (!bound.viavel) {
+        return falha("Nenhuma partição em " + to_string(p) + " subgrafos conexos com pelo menos dois vértices existe.", config.seed);
+    }
+    const Clock::time_point start = Clock::now();
+
+    PhaseTimes tempos;
+    vector<vector<uint32_t>> clusters;
+    if (initial) {
+        vector<uint32_t> label;
+        const string problem = valida_solucao(g, *initial, p, &label);
+        if (!problem.empty()) {
+            return falha("Solução inicial inválida: " + problem, config.seed);
+        }
+        clusters.assign(p, vector<uint32_t>());
+        for (uint32_t v = 0; v < n; ++v) {
+            clusters[label[v]].push_back(v);
+        }
+    } else if (!constroi_guloso(p, config.seed, clusters, tempos)) {
+        return falha("Nenhuma partição inicial válida para a busca tabu.", config.seed);
+    }
+    Clock::time_point phase_start = Clock::now();
+
+    // Mesma folga do reativo para parar no limite inferior
+    const float bound_gap = config.stop_at_bound ? bound.valor * (1 + 1e-6f) + 1e-6f : -1.0f;
+    TabuStats local_stats;
+    TabuStats& result = stats ? *stats : local_stats;
+    result = TabuStats();
+    vector<IncumbentRecord> improvements;
+    TabuSearch search(g, config);
+    search.run(clusters, max(config.target_gap, bound_gap), start, improvements, result);
+    tempos.busca_local = segundos_desde(phase_start);
+    phase_start = Clock::now();
+
+    Solution solution;
+    solution.semente = config.seed;
+    solution.limite_inferior = bound.valor;
+    solution.melhorias.swap(improvements);
+    solution.subgraphs.resize(p);
+    for (size_t i = 0; i < p; ++i) {
+        monta_subgrafo(search.best()[i], solution.subgraphs[i]);
+    }
+    calcula_gaps(solution);
+    tempos.saida = segundos_desde(phase_start);
+    registra_tempos(tempos);
+    return solution;
 }
 
+
+/// EXATO
+// O reativo fornece o incumbente inicial; o branch-and-bound procura algo
+// estritamente melhor. Se a árvore termina, a melhor das duas é ótima.
+Solution Graph::exato(size_t p, const ExactConfig& config, ExactStats* stats) {
+    const CSR& g = csr();
+    const size_t n = g.size();
+    if (p == 0 || p > n) {
+        return falha("O número de clusters deve estar entre 1 e o número de vértices.", config.seed);
+    }
+    const LowerBound& bound = limite_inferior(p);
+    if (!bound.viavel) {
+        return falha("Nenhuma partição em " + to_string(p) + " subgrafos conexos com pelo menos dois vértices existe.", config.seed);
+    }
+    const float lower = bound.valor;
+    const Clock::time_point start = Clock::now();
+
+    // Incumbente: o melhor entre reativo e adaptativo que seja uma partição válida
+    Solution solution;
+    if (config.heuristic_iterations > 0) {
+        GraspConfig grasp;
+        grasp.threads = config.threads;
+        grasp.seed = config.seed;
+        grasp.time_limit = config.time_limit;
+        solution = guloso_randomizado_adaptativo_reativo(p, config.heuristic_iterations, grasp);
+        if (!valida_solucao(g, solution, p).empty()) {
+            solution = Solution();
+        }
+        Solution adaptive = guloso_randomizado_adaptativo(p, grasp.alphas.front(), true, config.seed);
+        if (valida_solucao(g, adaptive, p).empty() && (solution.subgraphs.empty() || adaptive.total_gap < solution.total_gap)) {
+            solution = move(adaptive);
+        }
+    }
+    const double incumbent = solution.subgraphs.empty() ? numeric_limits<double>::infinity() : solution.total_gap;
+
+    ExactStats local_stats;
+    ExactStats& result = stats ? *stats : local_stats;
+    result = ExactStats();
+    if (incumbent <= lower * (1 + 1e-6f) + 1e-6f) {
+        // A heurística já alcançou o limite inferior
+        result.provado = true;
+        result.limite = incumbent;
+    } else {
+        ExactConfig search = config;
+        if (config.time_limit > 0) {
+            search.time_limit = max(config.time_limit - segundos_desde(start), 1e-9);
+        }
+        BranchAndBound tree(g, ordem_por_peso(), p);
+        if (tree.run(incumbent, search, result)) {
+            Clock::time_point output_start = Clock::now();
+            solution = Solution();
+            solution.subgraphs.resize(tree.clusters().size());
+            for (size_t i = 0; i < tree.clusters().size(); ++i) {
+                monta_subgrafo(tree.clusters()[i], solution.subgraphs[i]);
+            }
+            calcula_gaps(solution);
+            PhaseTimes tempos = this->tempos();
+            tempos.saida = segundos_desde(output_start);
+            registra_tempos(tempos);
+        }
+    }
+
+    solution.semente = config.seed;
+    if (solution.subgraphs.empty()) {
+        solution.erro = result.provado ? "Nenhuma partição em " + to_string(p) + " subgrafos conexos com pelo menos dois vértices existe."
+                                       : "Nenhuma partição encontrada dentro dos limites de tempo e de nós.";
+        return solution;
+    }
+    solution.otimo = result.provado;
+    solution.limite_inferior = result.provado ? solution.total_gap : max(lower, (float)result.limite);
+    return solution;
+}
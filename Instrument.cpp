@@ -0,0 +1,176 @@
+#include "include/Instrument.hpp"
+#include "include/defines.hpp"
+
+#ifdef INSTRUMENT
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+const char* const NOMES_CONTADORES[NUM_CONTADORES] = {
+    "buscas_id", "testes_conectividade", "articulacoes", "visitas_dfs", "candidatos_inseridos",
+    "candidatos_removidos", "reparos", "movimentos", "iteracoes",
+};
+
+thread_local uint64_t contadores_locais[NUM_CONTADORES];
+
+namespace {
+
+// O que a thread mediu desde o último descarregamento
+struct EstadoThread {
+    SessaoInstrumentada* sessao = nullptr;
+    vector<FaseTotal>    fases;
+    vector<EventoTrace>  eventos;
+    size_t               descartados = 0;
+};
+
+thread_local EstadoThread estado;
+atomic<uint32_t> proxima_thread(0);
+
+uint32_t numero_da_thread() {
+    static thread_local const uint32_t numero = proxima_thread++;
+    return numero;
+}
+
+FaseTotal& fase(vector<FaseTotal>& fases, const char* nome) {
+    for (FaseTotal& total : fases) {
+        if (total.nome == nome || strcmp(total.nome, nome) == 0) return total;
+    }
+    fases.push_back(FaseTotal{ nome, 0, 0.0 });
+    return fases.back();
+}
+
+double microssegundos(Clock::duration duration) {
+    return chrono::duration<double, micro>(duration).count();
+}
+
+// Escapa o que puder aparecer num nome de fase
+void escreve_texto(ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+SessaoInstrumentada::SessaoInstrumentada(bool trace, size_t max_eventos)
+    : _trace(trace), _max_eventos(max_eventos), _inicio(Clock::now()), _descartados(0) {
+    fill(_contadores, _contadores + NUM_CONTADORES, 0);
+}
+
+void SessaoInstrumentada::acumula(const uint64_t* contadores, const vector<FaseTotal>& fases,
+                                  vector<EventoTrace>& eventos, size_t descartados) {
+    lock_guard<mutex> lock(_mutex);
+    for (size_t c = 0; c < NUM_CONTADORES; ++c) {
+        _contadores[c] += contadores[c];
+    }
+    for (const FaseTotal& total : fases) {
+        FaseTotal& mine = fase(_fases, total.nome);
+        mine.chamadas += total.chamadas;
+        mine.segundos += total.segundos;
+    }
+    const size_t room = _max_eventos - min(_max_eventos, _eventos.size());
+    const size_t taken = min(room, eventos.size());
+    _eventos.insert(_eventos.end(), eventos.begin(), eventos.begin() + taken);
+    _descartados += descartados + (eventos.size() - taken);
+}
+
+void SessaoInstrumentada::escreve_resumo(ostream& out, double segundos) const {
+    out << "\"contadores\":{";
+    for (size_t c = 0; c < NUM_CONTADORES; ++c) {
+        out << (c ? "," : "") << '"' << NOMES_CONTADORES[c] << "\":" << _contadores[c];
+    }
+    out << "},\"fases\":{";
+    for (size_t f = 0; f < _fases.size(); ++f) {
+        out << (f ? "," : "");
+        escreve_texto(out, _fases[f].nome);
+        out << ":{\"chamadas\":" << _fases[f].chamadas << ",\"s\":" << _fases[f].segundos << '}';
+    }
+    out << "},\"iteracoes_por_s\":" << (segundos > 0 ? _contadores[ITERACOES] / segundos : 0.0);
+    if (_trace) {
+        out << ",\"eventos_descartados\":" << _descartados;
+    }
+}
+
+bool SessaoInstrumentada::escreve_trace(const string& path) const {
+    ofstream out(path);
+    if (!out) {
+        cerr << "Erro ao criar o arquivo de trace: " << path << "\n";
+        return false;
+    }
+    out << setprecision(15) << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    double end = 0;
+    for (size_t e = 0; e < _eventos.size(); ++e) {
+        const EventoTrace& evento = _eventos[e];
+        out << (e ? ",\n" : "") << "{\"name\":";
+        escreve_texto(out, evento.nome);
+        out << ",\"cat\":\"fase\",\"ph\":\"X\",\"pid\":1,\"tid\":" << evento.thread << ",\"ts\":" << evento.inicio
+            << ",\"dur\":" << evento.duracao << '}';
+        end = max(end, evento.inicio + evento.duracao);
+    }
+    // Os totais dos contadores num evento de contador no fim da execução
+    out << (_eventos.empty() ? "" : ",\n") << "{\"name\":\"contadores\",\"ph\":\"C\",\"pid\":1,\"tid\":0,\"ts\":" << end
+        << ",\"args\":{";
+    for (size_t c = 0; c < NUM_CONTADORES; ++c) {
+        out << (c ? "," : "") << '"' << NOMES_CONTADORES[c] << "\":" << _contadores[c];
+    }
+    out << "}}\n]}\n";
+    if (!out.flush()) {
+        cerr << "Erro ao gravar o arquivo de trace: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Passa o que a thread mediu para a sessão (nenhuma: descarta) e zera a thread
+void EscopoInstrumentado::descarrega(SessaoInstrumentada* sessao) {
+    if (sessao) {
+        sessao->acumula(contadores_locais, estado.fases, estado.eventos, estado.descartados);
+    }
+    fill(contadores_locais, contadores_locais + NUM_CONTADORES, 0);
+    estado.fases.clear();
+    estado.eventos.clear();
+    estado.descartados = 0;
+}
+
+EscopoInstrumentado::EscopoInstrumentado(SessaoInstrumentada* sessao)
+    : _sessao(sessao), _anterior(estado.sessao), _ativo(sessao != estado.sessao) {
+    if (_ativo) {
+        descarrega(_anterior);
+        estado.sessao = sessao;
+    }
+}
+
+void EscopoInstrumentado::encerra() {
+    if (!_ativo) return;
+    _ativo = false;
+    descarrega(_sessao);
+    estado.sessao = _anterior;
+}
+
+void FaseMedida::encerra() {
+    SessaoInstrumentada* sessao = estado.sessao;
+    if (!_ativa || !sessao) return;
+    _ativa = false;
+    const Clock::time_point end = Clock::now();
+    FaseTotal& total = fase(estado.fases, _nome);
+    total.chamadas++;
+    total.segundos += chrono::duration<double>(end - _inicio).count();
+    if (sessao->_trace) {
+        if (estado.eventos.size() < sessao->_max_eventos) {
+            estado.eventos.push_back(EventoTrace{ _nome, numero_da_thread(), microssegundos(_inicio - sessao->_inicio),
+                                                  microssegundos(end - _inicio) });
+        } else {
+            estado.descartados++;
+        }
+    }
+}
+
+SessaoInstrumentada* sessao_atual() {
+    return estado.sessao;
+}
+
+#endif  //INSTRUMENT
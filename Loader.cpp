@@ -0,0 +1,353 @@
+#include "include/Loader.hpp"
+#include "include/NodeIndex.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+namespace {
+
+const uint32_t NONE = numeric_limits<uint32_t>::max();
+
+// Tokenizador mínimo sobre o buffer: ignora espaços e comentários '#'
+struct Scanner {
+    const char* cur;
+    const char* end;
+
+    void skip() {
+        while (cur < end) {
+            if (*cur == '#') {
+                while (cur < end && *cur != '\n') ++cur;
+            } else if (isspace((unsigned char)*cur)) {
+                ++cur;
+            } else {
+                break;
+            }
+        }
+    }
+
+    bool done() {
+        skip();
+        return cur >= end;
+    }
+
+    bool peek(char c) {
+        skip();
+        return cur < end && *cur == c;
+    }
+
+    bool accept(const char* token) {
+        skip();
+        const char* p = cur;
+        while (*token && p < end && *p == *token) {
+            ++p;
+            ++token;
+        }
+        if (*token) return false;
+        cur = p;
+        return true;
+    }
+
+    // Palavra alfanumérica (nome de seção); vazia se não houver
+    string word() {
+        skip();
+        const char* begin = cur;
+        while (cur < end && (isalnum((unsigned char)*cur) || *cur == '_')) ++cur;
+        return string(begin, cur);
+    }
+
+    bool integer(size_t& value) {
+        skip();
+        if (cur >= end || !isdigit((unsigned char)*cur)) return false;
+        value = 0;
+        while (cur < end && isdigit((unsigned char)*cur)) {
+            value = value * 10 + (*cur - '0');
+            ++cur;
+        }
+        return true;
+    }
+
+    bool real(float& value) {
+        skip();
+        const char* begin = cur;
+        bool negative = false;
+        if (cur < end && (*cur == '-' || *cur == '+')) {
+            negative = *cur == '-';
+            ++cur;
+        }
+        double result = 0;
+        bool digits = false;
+        while (cur < end && isdigit((unsigned char)*cur)) {
+            result = result * 10 + (*cur - '0');
+            ++cur;
+            digits = true;
+        }
+        if (cur < end && *cur == '.') {
+            ++cur;
+            double scale = 0.1;
+            while (cur < end && isdigit((unsigned char)*cur)) {
+                result += (*cur - '0') * scale;
+                scale *= 0.1;
+                ++cur;
+                digits = true;
+            }
+        }
+        if (!digits) {
+            cur = begin;
+            return false;
+        }
+        if (cur < end && (*cur == 'e' || *cur == 'E')) {
+            ++cur;
+            bool negative_exponent = cur < end && *cur == '-';
+            if (cur < end && (*cur == '-' || *cur == '+')) ++cur;
+            int exponent = 0;
+            while (cur < end && isdigit((unsigned char)*cur)) {
+                exponent = exponent * 10 + (*cur - '0');
+                ++cur;
+            }
+            result *= pow(10.0, negative_exponent ? -exponent : exponent);
+        }
+        value = negative ? -result : result;
+        return true;
+    }
+
+    // Avança até depois do próximo ';'
+    void skip_statement() {
+        while (cur < end && *cur != ';') {
+            if (*cur == '#') {
+                skip();
+            } else {
+                ++cur;
+            }
+        }
+        if (cur < end) ++cur;
+    }
+};
+
+// Lê a próxima aresta "(a,b)" da seção set E; false ao chegar no ';'
+bool next_edge(Scanner& scanner, size_t& a, size_t& b) {
+    while (!scanner.done() && !scanner.peek(';')) {
+        if (scanner.accept("(") && scanner.integer(a) && scanner.accept(",") && scanner.integer(b) && scanner.accept(")")) {
+            return true;
+        }
+        // Tupla malformada ou com outra aridade: descarta até o fim dela
+        while (scanner.cur < scanner.end && *scanner.cur != ')' && *scanner.cur != ';') ++scanner.cur;
+        if (scanner.cur < scanner.end && *scanner.cur == ')') ++scanner.cur;
+    }
+    return false;
+}
+
+} // namespace
+
+bool carrega_instancia(const char* data, size_t size, CSR& graph, size_t& num_clusters) {
+    CSR::Storage& csr = graph.storage;
+    Scanner scanner{ data, data + size };
+    IdIndex<uint32_t, NONE> index_of;
+    csr.ids.clear();
+    csr.weights.clear();
+    const char* edges_begin = nullptr;
+
+    auto vertex = [&](size_t id) {
+        uint32_t index = index_of.find(id);
+        if (index == NONE) {
+            index = csr.ids.size();
+            index_of.insert(id, index);
+            csr.ids.push_back(id);
+            csr.weights.push_back(0.0f);
+        }
+        return index;
+    };
+
+    while (!scanner.done()) {
+        string keyword = scanner.word();
+        if (keyword == "end") {
+            break;
+        }
+        string name = (keyword == "param" || keyword == "set") ? scanner.word() : string();
+        if (!scanner.accept(":=")) {
+            scanner.skip_statement();
+            continue;
+        }
+
+        if (keyword == "param" && name == "p") {
+            size_t p;
+            if (!scanner.integer(p)) {
+                cerr << "Erro: valor inválido em param p." << endl;
+                return false;
+            }
+            num_clusters = p;
+            scanner.skip_statement();
+        } else if (keyword == "set" && name == "V") {
+            size_t id;
+            while (scanner.integer(id)) {
+                vertex(id);
+            }
+            scanner.skip_statement();
+        } else if (keyword == "param" && name == "w") {
+            size_t id;
+            float weight;
+            while (scanner.integer(id) && scanner.real(weight)) {
+                csr.weights[vertex(id)] = weight;
+            }
+            scanner.skip_statement();
+        } else if (keyword == "set" && name == "E") {
+            // As arestas são lidas depois, quando todos os vértices já são conhecidos
+            edges_begin = scanner.cur;
+            scanner.skip_statement();
+        } else {
+            scanner.skip_statement();
+        }
+    }
+
+    const size_t n = csr.ids.size();
+    csr.offsets.assign(n + 1, 0);
+    csr.targets.clear();
+    if (!edges_begin) {
+        graph.attach_storage();
+        return true;
+    }
+
+    // Primeira passada: graus (cada aresta conta nos dois sentidos)
+    Scanner edges{ edges_begin, data + size };
+    size_t a, b;
+    while (next_edge(edges, a, b)) {
+        uint32_t u = index_of.find(a);
+        uint32_t v = index_of.find(b);
+        if (u != NONE && v != NONE) {
+            csr.offsets[u + 1]++;
+            csr.offsets[v + 1]++;
+        }
+    }
+    for (size_t v = 0; v < n; ++v) {
+        csr.offsets[v + 1] += csr.offsets[v];
+    }
+
+    // Segunda passada: preencher os vizinhos
+    csr.targets.resize(csr.offsets[n]);
+    vector<size_t> cursor(csr.offsets.begin(), csr.offsets.end() - 1);
+    edges.cur = edges_begin;
+    while (next_edge(edges, a, b)) {
+        uint32_t u = index_of.find(a);
+        uint32_t v = index_of.find(b);
+        if (u != NONE && v != NONE) {
+            csr.targets[cursor[u]++] = v;
+            csr.targets[cursor[v]++] = u;
+        }
+    }
+
+    // Remover arestas repetidas ordenando cada lista de vizinhos e compactando no lugar
+    size_t write = 0;
+    for (size_t v = 0; v < n; ++v) {
+        uint32_t* begin = csr.targets.data() + csr.offsets[v];
+        uint32_t* end = csr.targets.data() + csr.offsets[v + 1];
+        sort(begin, end);
+        end = unique(begin, end);
+        csr.offsets[v] = write;
+        for (uint32_t* neighbor = begin; neighbor != end; ++neighbor) {
+            csr.targets[write++] = *neighbor;
+        }
+    }
+    csr.offsets[n] = write;
+    csr.targets.resize(write);
+    csr.targets.shrink_to_fit();
+    graph.attach_storage();
+    return true;
+}
+
+namespace {
+
+const char BINARY_MAGIC[8] = { 'T', 'D', 'G', 'R', 'A', 'F', 'O', 'B' };
+
+size_t alinha(size_t bytes) {
+    return (bytes + 7) & ~size_t(7);
+}
+
+} // namespace
+
+bool eh_binario(const char* data, size_t size) {
+    return size >= sizeof(BinaryHeader) && memcmp(data, BINARY_MAGIC, sizeof(BINARY_MAGIC)) == 0;
+}
+
+// Aponta a CSR para os arrays dentro do arquivo mapeado, sem copiar nenhum elemento.
+// Além do cabeçalho, offsets e targets são conferidos numa passada O(n + m), para que
+// um arquivo corrompido não faça os algoritmos lerem fora dos arrays.
+bool carrega_binario(const shared_ptr<MappedFile>& file, CSR& csr, size_t& num_clusters) {
+    const char* data = file->data();
+    const size_t size = file->size();
+    if (!eh_binario(data, size)) {
+        cerr << "Erro: arquivo binário sem o cabeçalho esperado." << endl;
+        return false;
+    }
+
+    BinaryHeader header;
+    memcpy(&header, data, sizeof(header));
+    if (header.version != BINARY_VERSION || header.byte_order != BINARY_BYTE_ORDER) {
+        cerr << "Erro: versão ou ordem de bytes do arquivo binário não suportada." << endl;
+        return false;
+    }
+
+    const size_t n = header.num_vertices;
+    const size_t m = header.num_arcs;
+    if (n >= size / sizeof(uint64_t) || m > size / sizeof(uint32_t)) {
+        cerr << "Erro: arquivo binário truncado." << endl;
+        return false;
+    }
+    const size_t offsets_at = sizeof(BinaryHeader);
+    const size_t ids_at = offsets_at + (n + 1) * sizeof(uint64_t);
+    const size_t weights_at = ids_at + n * sizeof(uint64_t);
+    const size_t targets_at = weights_at + alinha(n * sizeof(float));
+    if (targets_at + m * sizeof(uint32_t) > size) {
+        cerr << "Erro: arquivo binário truncado." << endl;
+        return false;
+    }
+
+    const uint64_t* offsets = reinterpret_cast<const uint64_t*>(data + offsets_at);
+    const uint32_t* targets = reinterpret_cast<const uint32_t*>(data + targets_at);
+    bool consistent = offsets[0] == 0 && offsets[n] == m;
+    for (size_t v = 0; v < n && consistent; ++v) {
+        consistent = offsets[v] <= offsets[v + 1];
+    }
+    for (size_t i = 0; i < m && consistent; ++i) {
+        consistent = targets[i] < n;
+    }
+    if (!consistent) {
+        cerr << "Erro: arquivo binário inconsistente." << endl;
+        return false;
+    }
+
+    csr.storage = CSR::Storage();
+    csr.mapping = file;
+    csr.num_vertices = n;
+    csr.num_arcs = m;
+    csr.offsets = offsets;
+    csr.ids = reinterpret_cast<const uint64_t*>(data + ids_at);
+    csr.weights = reinterpret_cast<const float*>(data + weights_at);
+    csr.targets = targets;
+    num_clusters = header.num_clusters;
+    return true;
+}
+
+bool escreve_binario(const CSR& csr, size_t num_clusters, const string& path) {
+    ofstream output(path, ios::binary | ios::trunc);
+    if (!output) {
+        cerr << "Erro ao criar o arquivo binário: " << path << endl;
+        return false;
+    }
+
+    BinaryHeader header;
+    memcpy(header.magic, BINARY_MAGIC, sizeof(BINARY_MAGIC));
+    header.version = BINARY_VERSION;
+    header.byte_order = BINARY_BYTE_ORDER;
+    header.num_clusters = num_clusters;
+    header.num_vertices = csr.size();
+    header.num_arcs = csr.num_arcs;
+
+    const size_t n = csr.size();
+    const char padding[8] = {};
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.write(reinterpret_cast<const char*>(csr.offsets), (n + 1) * sizeof(uint64_t));
+    output.write(reinterpret_cast<const char*>(csr.ids), n * sizeof(uint64_t));
+    output.write(reinterpret_cast<const char*>(csr.weights), n * sizeof(float));
+    output.write(padding, alinha(n * sizeof(float)) - n * sizeof(float));
+    output.write(reinterpret_cast<const char*>(csr.targets), csr.num_arcs * sizeof(uint32_t));
+    return bool(output);
+}
@@ -0,0 +1,279 @@
+#include "include/LocalSearch.hpp"
+#include "include/Instrument.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+// Tolerância para considerar que um movimento melhora o gap
+static const float EPSILON = 1e-6f;
+
+LocalSearch::LocalSearch(const CSR& graph) : _graph(graph), _recycler(new NodeRecycler), _epoch(0) {
+    const size_t n = graph.size();
+    _label.assign(n, Partition::NONE);
+    _position.assign(n, 0);
+    _articulation.assign(n, 0);
+    _stamp.assign(n, 0);
+    _disc.assign(n, 0);
+    _low.assign(n, 0);
+    _edge_pos.assign(n, 0);
+}
+
+// Desfaz a carga anterior em O(vértices carregados), mantendo a capacidade dos buffers
+void LocalSearch::clear(size_t num_clusters) {
+    for (vector<uint32_t>& members : _members) {
+        for (uint32_t v : members) {
+            _label[v] = Partition::NONE;
+        }
+        members.clear();
+    }
+    for (WeightSet& weights : _weights) {
+        weights.clear();
+    }
+    _members.resize(num_clusters);
+    _weights.resize(num_clusters, WeightSet(less<float>(), RecyclingAllocator<float>(_recycler.get())));
+    _dirty.assign(num_clusters, 1);
+}
+
+void LocalSearch::load(const vector<vector<uint32_t>>& clusters) {
+    clear(clusters.size());
+    for (uint32_t c = 0; c < clusters.size(); ++c) {
+        for (uint32_t v : clusters[c]) {
+            insert(v, c);
+        }
+    }
+}
+
+void LocalSearch::load(const Partition& partition) {
+    clear(partition.num_clusters());
+    for (uint32_t c = 0; c < partition.num_clusters(); ++c) {
+        for (uint32_t v : partition.members(c)) {
+            insert(v, c);
+        }
+    }
+}
+
+float LocalSearch::gap(uint32_t c) const {
+    const WeightSet& weights = _weights[c];
+    return weights.empty() ? 0.0f : *weights.rbegin() - *weights.begin();
+}
+
+float LocalSearch::total_gap() const {
+    float total = 0;
+    for (uint32_t c = 0; c < _members.size(); ++c) {
+        total += gap(c);
+    }
+    return total;
+}
+
+// Gap do cluster c sem um vértice de peso removed (que pertence a c)
+float LocalSearch::gap_without(uint32_t c, float removed) const {
+    const WeightSet& weights = _weights[c];
+    if (weights.size() <= 1) return 0.0f;
+    float low = removed == *weights.begin() ? *next(weights.begin()) : *weights.begin();
+    float high = removed == *weights.rbegin() ? *next(weights.rbegin()) : *weights.rbegin();
+    return high - low;
+}
+
+float LocalSearch::gap_with(uint32_t c, float added) const {
+    const WeightSet& weights = _weights[c];
+    if (weights.empty()) return 0.0f;
+    return max(*weights.rbegin(), added) - min(*weights.begin(), added);
+}
+
+float LocalSearch::gap_exchanging(uint32_t c, float removed, float added) const {
+    const WeightSet& weights = _weights[c];
+    if (weights.size() <= 1) return 0.0f;
+    float low = removed == *weights.begin() ? *next(weights.begin()) : *weights.begin();
+    float high = removed == *weights.rbegin() ? *next(weights.rbegin()) : *weights.rbegin();
+    return max(high, added) - min(low, added);
+}
+
+float LocalSearch::relocate_delta(uint32_t v, uint32_t to) const {
+    const uint32_t from = _label[v];
+    const float w = _graph.weights[v];
+    return (gap_without(from, w) - gap(from)) + (gap_with(to, w) - gap(to));
+}
+
+float LocalSearch::swap_delta(uint32_t u, uint32_t v) const {
+    const uint32_t a = _label[u];
+    const uint32_t b = _label[v];
+    const float wu = _graph.weights[u];
+    const float wv = _graph.weights[v];
+    return (gap_exchanging(a, wu, wv) - gap(a)) + (gap_exchanging(b, wv, wu) - gap(b));
+}
+
+// v pode ir para to se o cluster de origem continua com 2+ vértices e conexo, e v toca to
+bool LocalSearch::can_relocate(uint32_t v, uint32_t to) {
+    INSTRUMENT_COUNT(TESTES_CONECTIVIDADE);
+    const uint32_t from = _label[v];
+    if (from == to || _members[from].size() <= 2) return false;
+    bool adjacent = false;
+    for (const uint32_t* neighbor = _graph.begin(v); neighbor != _graph.end(v) && !adjacent; ++neighbor) {
+        adjacent = _label[*neighbor] == to;
+    }
+    return adjacent && !is_articulation(v);
+}
+
+bool LocalSearch::can_swap(uint32_t u, uint32_t v) {
+    const uint32_t a = _label[u];
+    const uint32_t b = _label[v];
+    if (a == b) return false;
+    INSTRUMENT_COUNT(TESTES_CONECTIVIDADE);
+    return connected_after_exchange(a, u, v) && connected_after_exchange(b, v, u);
+}
+
+void LocalSearch::relocate(uint32_t v, uint32_t to) {
+    INSTRUMENT_COUNT(MOVIMENTOS);
+    erase(v);
+    insert(v, to);
+}
+
+void LocalSearch::swap(uint32_t u, uint32_t v) {
+    INSTRUMENT_COUNT(MOVIMENTOS);
+    const uint32_t a = _label[u];
+    const uint32_t b = _label[v];
+    erase(u);
+    erase(v);
+    insert(u, b);
+    insert(v, a);
+}
+
+void LocalSearch::insert(uint32_t v, uint32_t c) {
+    _label[v] = c;
+    _position[v] = _members[c].size();
+    _members[c].push_back(v);
+    _weights[c].insert(_graph.weights[v]);
+    _dirty[c] = 1;
+}
+
+void LocalSearch::erase(uint32_t v) {
+    const uint32_t c = _label[v];
+    vector<uint32_t>& members = _members[c];
+    uint32_t last = members.back();
+    members[_position[v]] = last;
+    _position[last] = _position[v];
+    members.pop_back();
+    _weights[c].erase(_weights[c].find(_graph.weights[v]));
+    _label[v] = Partition::NONE;
+    _dirty[c] = 1;
+}
+
+bool LocalSearch::is_articulation(uint32_t v) {
+    if (_dirty[_label[v]]) {
+        compute_articulations(_label[v]);
+    }
+    return _articulation[v];
+}
+
+// Pontos de articulação do subgrafo induzido pelo cluster c (Tarjan iterativo)
+void LocalSearch::compute_articulations(uint32_t c) {
+    INSTRUMENT_COUNT(ARTICULACOES);
+    const vector<uint32_t>& members = _members[c];
+    _dirty[c] = 0;
+    for (uint32_t v : members) {
+        _articulation[v] = 0;
+    }
+    if (members.empty()) return;
+
+    ++_epoch;
+    uint32_t timer = 1;
+    const uint32_t root = members[0];
+    size_t root_children = 0;
+    _stamp[root] = _epoch;
+    _disc[root] = _low[root] = timer++;
+    _edge_pos[root] = _graph.offsets[root];
+    _stack.assign(1, root);
+
+    while (!_stack.empty()) {
+        uint32_t v = _stack.back();
+        if (_edge_pos[v] < _graph.offsets[v + 1]) {
+            uint32_t u = _graph.targets[_edge_pos[v]++];
+            if (_label[u] != c) continue;
+            if (_stamp[u] != _epoch) {
+                _stamp[u] = _epoch;
+                _disc[u] = _low[u] = timer++;
+                _edge_pos[u] = _graph.offsets[u];
+                _stack.push_back(u);
+                if (v == root) root_children++;
+            } else {
+                _low[v] = min(_low[v], _disc[u]);
+            }
+        } else {
+            _stack.pop_back();
+            if (!_stack.empty()) {
+                uint32_t parent = _stack.back();
+                _low[parent] = min(_low[parent], _low[v]);
+                if (parent != root && _low[v] >= _disc[parent]) {
+                    _articulation[parent] = 1;
+                }
+            }
+        }
+    }
+    if (root_children > 1) {
+        _articulation[root] = 1;
+    }
+    INSTRUMENT_ADD(VISITAS_DFS, timer - 1);
+}
+
+// O cluster c continua conexo trocando removed (membro de c) por added?
+bool LocalSearch::connected_after_exchange(uint32_t c, uint32_t removed, uint32_t added) {
+    ++_epoch;
+    _stamp[removed] = _epoch; // nunca visitado
+    _stamp[added] = _epoch;
+    _stack.assign(1, added);
+    size_t reached = 1;
+    while (!_stack.empty()) {
+        uint32_t v = _stack.back();
+        _stack.pop_back();
+        for (const uint32_t* neighbor = _graph.begin(v); neighbor != _graph.end(v); ++neighbor) {
+            if (_label[*neighbor] == c && _stamp[*neighbor] != _epoch) {
+                _stamp[*neighbor] = _epoch;
+                _stack.push_back(*neighbor);
+                reached++;
+            }
+        }
+    }
+    INSTRUMENT_ADD(VISITAS_DFS, reached);
+    return reached == _members[c].size();
+}
+
+// Primeira melhora: percorre os vértices tentando realocação e depois troca,
+// até uma passada inteira sem melhora ou o prazo. Retorna o gap total final.
+float LocalSearch::run(size_t max_passes, Deadline deadline) {
+    INSTRUMENT_PHASE("busca_local");
+    const bool timed = deadline != Deadline::max();
+    size_t since_check = 0;
+    bool improved = true;
+    for (size_t pass = 0; improved && pass < max_passes; ++pass) {
+        improved = false;
+        for (uint32_t v = 0; v < _graph.size(); ++v) {
+            if (timed && (since_check += _graph.degree(v)) >= DEADLINE_CHECK) {
+                since_check = 0;
+                if (chrono::steady_clock::now() >= deadline) {
+                    return total_gap();
+                }
+            }
+            if (_label[v] == Partition::NONE) continue;
+
+            bool moved = false;
+            for (const uint32_t* neighbor = _graph.begin(v); neighbor != _graph.end(v) && !moved; ++neighbor) {
+                uint32_t to = _label[*neighbor];
+                if (to == Partition::NONE || to == _label[v]) continue;
+                if (relocate_delta(v, to) < -EPSILON && can_relocate(v, to)) {
+                    relocate(v, to);
+                    moved = true;
+                }
+            }
+            for (const uint32_t* neighbor = _graph.begin(v); neighbor != _graph.end(v) && !moved; ++neighbor) {
+                uint32_t u = *neighbor;
+                if (_label[u] == Partition::NONE || _label[u] == _label[v]) continue;
+                if (swap_delta(v, u) < -EPSILON && can_swap(v, u)) {
+                    swap(v, u);
+                    moved = true;
+                }
+            }
+            improved = improved || moved;
+        }
+    }
+    return total_gap();
+}
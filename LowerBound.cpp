@@ -0,0 +1,152 @@
+#include "include/LowerBound.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+namespace {
+
+const double NEG = -numeric_limits<double>::infinity();
+const double INF = numeric_limits<double>::infinity();
+
+// best[k] = maior soma de k buracos na sequência crescente a[0..m-1], para
+// k = 0..max_cuts (NEG se impossível). O buraco i fica entre a[i] e a[i+1]
+// e vale a[i+1] - a[i]; trechos têm pelo menos 2 elementos e buracos marcados
+// em forbidden não podem ser usados.
+vector<double> melhores_buracos(const vector<float>& a, const vector<char>& forbidden, size_t max_cuts) {
+    const size_t m = a.size();
+    vector<double> best(max_cuts + 1, NEG);
+    best[0] = 0;
+    if (max_cuts == 0 || m < 4) {
+        return best;
+    }
+
+    // Buraco i válido: 1 <= i <= m - 3 (dois elementos de cada lado) e não proibido
+    vector<double> previous(m - 1, NEG), current(m - 1, NEG);
+    for (size_t i = 1; i + 3 <= m; ++i) {
+        if (!forbidden[i]) {
+            previous[i] = a[i + 1] - a[i];
+            best[1] = max(best[1], previous[i]);
+        }
+    }
+    for (size_t k = 2; k <= max_cuts && best[k - 1] != NEG; ++k) {
+        // Com o buraco anterior em j, o próximo precisa de j <= i - 2
+        double prefix = NEG;
+        fill(current.begin(), current.end(), NEG);
+        for (size_t i = 3; i + 3 <= m; ++i) {
+            prefix = max(prefix, previous[i - 2]);
+            if (!forbidden[i] && prefix != NEG) {
+                current[i] = prefix + (a[i + 1] - a[i]);
+                best[k] = max(best[k], current[i]);
+            }
+        }
+        previous.swap(current);
+    }
+    return best;
+}
+
+} // namespace
+
+LowerBound calcula_limite_inferior(const CSR& graph, size_t p) {
+    LowerBound bound;
+    const size_t n = graph.size();
+    if (p == 0 || n < 2 * p) {
+        bound.viavel = false;
+        return bound;
+    }
+
+    // Componentes conexas por busca em largura
+    vector<uint32_t> component(n, numeric_limits<uint32_t>::max());
+    vector<vector<uint32_t>> members;
+    for (uint32_t root = 0; root < n; ++root) {
+        if (component[root] != numeric_limits<uint32_t>::max()) continue;
+        const uint32_t c = members.size();
+        members.emplace_back(1, root);
+        component[root] = c;
+        for (size_t head = 0; head < members[c].size(); ++head) {
+            uint32_t v = members[c][head];
+            for (const uint32_t* neighbor = graph.begin(v); neighbor != graph.end(v); ++neighbor) {
+                if (component[*neighbor] == numeric_limits<uint32_t>::max()) {
+                    component[*neighbor] = c;
+                    members[c].push_back(*neighbor);
+                }
+            }
+        }
+    }
+    bound.componentes = members.size();
+    if (members.size() > p) {
+        bound.viavel = false;
+        return bound;
+    }
+
+    // total[q] = menor soma usando q clusters nas componentes já vistas
+    vector<double> total(p + 1, INF);
+    total[0] = 0;
+    vector<float> weights;
+    vector<char> forbidden;
+    for (const vector<uint32_t>& vertices : members) {
+        const size_t m = vertices.size();
+        if (m < 2) {
+            bound.viavel = false;
+            return bound;
+        }
+        weights.clear();
+        for (uint32_t v : vertices) {
+            weights.push_back(graph.weights[v]);
+        }
+        sort(weights.begin(), weights.end());
+
+        // Folha e vizinho no mesmo cluster: nenhum buraco dentro de [mín, máx] do par
+        forbidden.assign(m, 0);
+        vector<int> coverage(m + 1, 0);
+        for (uint32_t v : vertices) {
+            if (graph.degree(v) != 1) continue;
+            float lo = min(graph.weights[v], graph.weights[*graph.begin(v)]);
+            float hi = max(graph.weights[v], graph.weights[*graph.begin(v)]);
+            // Buracos i com lo <= a[i] e a[i + 1] <= hi
+            size_t first = lower_bound(weights.begin(), weights.end(), lo) - weights.begin();
+            size_t last = upper_bound(weights.begin(), weights.end(), hi) - weights.begin();
+            if (last >= first + 2) {
+                coverage[first]++;
+                coverage[last - 1]--;
+            }
+        }
+        int running = 0;
+        for (size_t i = 0; i < m; ++i) {
+            running += coverage[i];
+            forbidden[i] = running > 0;
+        }
+
+        const size_t max_clusters = min(p, m / 2);
+        vector<double> holes = melhores_buracos(weights, forbidden, max_clusters - 1);
+        const double span = weights.back() - weights.front();
+
+        // Com k clusters na componente há no máximo k - 1 buracos (clusters
+        // intercalados deixam menos), então vale o melhor com até k - 1
+        for (size_t k = 1; k < holes.size(); ++k) {
+            holes[k] = max(holes[k], holes[k - 1]);
+        }
+
+        vector<double> next(p + 1, INF);
+        for (size_t used = 0; used < p; ++used) {
+            if (total[used] == INF) continue;
+            for (size_t k = 1; k <= max_clusters && used + k <= p; ++k) {
+                next[used + k] = min(next[used + k], total[used] + span - holes[k - 1]);
+            }
+        }
+        total.swap(next);
+    }
+
+    if (total[p] == INF) {
+        bound.viavel = false;
+        return bound;
+    }
+    bound.valor = max(0.0, total[p]);
+    return bound;
+}
+
+double gap_restante_pct(float gap, float limite) {
+    if (gap <= 0) {
+        return 0.0;
+    }
+    return max(0.0, 100.0 * (gap - limite) / gap);
+}
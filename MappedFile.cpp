@@ -0,0 +1,39 @@
+#include "include/MappedFile.hpp"
+#include "include/defines.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+MappedFile::MappedFile(const string& path) : _fd(-1), _open(false), _data(nullptr), _size(0) {
+    _fd = open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (_fd < 0 || fstat(_fd, &info) != 0) {
+        return;
+    }
+    _size = info.st_size;
+    if (_size == 0) {
+        _open = true;
+        return;
+    }
+
+    void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _fd, 0);
+    if (data == MAP_FAILED) {
+        return;
+    }
+    madvise(data, _size, MADV_SEQUENTIAL);
+    _data = data;
+    _open = true;
+}
+
+MappedFile::~MappedFile() {
+    if (_data) {
+        munmap(_data, _size);
+    }
+    if (_fd >= 0) {
+        close(_fd);
+    }
+}
@@ -0,0 +1,116 @@
+#include "include/Partition.hpp"
+#include "include/Instrument.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+Partition::Partition(const CSR& graph, size_t num_clusters)
+    : _graph(graph), _label(graph.size(), NONE), _queued(graph.size(), 0) {
+    reset(num_clusters);
+}
+
+// Desfaz só os rótulos atribuídos desde o último reset, em O(vértices atribuídos);
+// os vetores por cluster são esvaziados sem perder a capacidade
+void Partition::reset(size_t num_clusters) {
+    for (vector<uint32_t>& members : _members) {
+        for (uint32_t v : members) {
+            _label[v] = NONE;
+        }
+        members.clear();
+    }
+    for (vector<uint32_t>& frontier : _frontier) {
+        frontier.clear();
+    }
+    _members.resize(num_clusters);
+    _frontier.resize(num_clusters);
+    _frontier_head.assign(num_clusters, 0);
+    _min_weight.assign(num_clusters, numeric_limits<float>::max());
+    _max_weight.assign(num_clusters, numeric_limits<float>::lowest());
+    _num_assigned = 0;
+}
+
+// Coloca v no cluster c e estende a fronteira de c com os vizinhos livres de v
+void Partition::assign(uint32_t v, uint32_t c) {
+    _label[v] = c;
+    _members[c].push_back(v);
+    _min_weight[c] = min(_min_weight[c], _graph.weights[v]);
+    _max_weight[c] = max(_max_weight[c], _graph.weights[v]);
+    ++_num_assigned;
+
+    for (const uint32_t* neighbor = _graph.begin(v); neighbor != _graph.end(v); ++neighbor) {
+        if (_label[*neighbor] == NONE) {
+            _frontier[c].push_back(*neighbor);
+        }
+    }
+}
+
+bool Partition::is_adjacent(uint32_t v, uint32_t c) const {
+    for (const uint32_t* neighbor = _graph.begin(v); neighbor != _graph.end(v); ++neighbor) {
+        if (_label[*neighbor] == c) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Menor índice de cluster vizinho de v (NONE se v não toca nenhum cluster)
+uint32_t Partition::first_adjacent_cluster(uint32_t v) const {
+    uint32_t best = NONE;
+    for (const uint32_t* neighbor = _graph.begin(v); neighbor != _graph.end(v); ++neighbor) {
+        best = min(best, _label[*neighbor]);
+    }
+    return best;
+}
+
+// Se v ainda tem algum vizinho livre
+bool Partition::has_free_neighbor(uint32_t v) const {
+    for (const uint32_t* neighbor = _graph.begin(v); neighbor != _graph.end(v); ++neighbor) {
+        if (_label[*neighbor] == NONE) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Próximo vértice livre adjacente a c, sem consumi-lo (NONE se a fronteira acabou)
+uint32_t Partition::next_frontier(uint32_t c) {
+    vector<uint32_t>& frontier = _frontier[c];
+    size_t& head = _frontier_head[c];
+    while (head < frontier.size() && _label[frontier[head]] != NONE) {
+        ++head;
+    }
+    return head < frontier.size() ? frontier[head] : NONE;
+}
+
+// Distribui os vértices livres alcançáveis a partir dos clusters: cada vértice
+// vai para o primeiro cluster adjacente, e seus vizinhos livres passam a ser
+// candidatos. O(n + m) no total. Retorna quantos vértices foram atribuídos.
+size_t Partition::repair() {
+    INSTRUMENT_COUNT(REPAROS);
+    size_t before = _num_assigned;
+    vector<uint32_t>& queue = _queue;
+    vector<char>& queued = _queued;
+    queue.clear();
+    for (uint32_t v = 0; v < _graph.size(); ++v) {
+        if (_label[v] == NONE && first_adjacent_cluster(v) != NONE) {
+            queue.push_back(v);
+            queued[v] = 1;
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        uint32_t v = queue[head];
+        assign(v, first_adjacent_cluster(v));
+        for (const uint32_t* neighbor = _graph.begin(v); neighbor != _graph.end(v); ++neighbor) {
+            if (_label[*neighbor] == NONE && !queued[*neighbor]) {
+                queue.push_back(*neighbor);
+                queued[*neighbor] = 1;
+            }
+        }
+    }
+    INSTRUMENT_ADD(VISITAS_DFS, queue.size());
+    for (uint32_t v : queue) {
+        queued[v] = 0;
+    }
+    return _num_assigned - before;
+}
@@ -0,0 +1,122 @@
+#include "include/RankFrontier.hpp"
+#include "include/Instrument.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+WeightOrder::WeightOrder(const CSR& graph) : order(graph.size()), rank(graph.size()), sorted(graph.size()) {
+    for (uint32_t v = 0; v < graph.size(); ++v) {
+        order[v] = v;
+    }
+    stable_sort(order.begin(), order.end(),
+                [&](uint32_t a, uint32_t b) { return graph.weights[a] < graph.weights[b]; });
+    for (uint32_t r = 0; r < order.size(); ++r) {
+        rank[order[r]] = r;
+        sorted[r] = graph.weights[order[r]];
+    }
+}
+
+uint32_t WeightOrder::first_at_least(float weight) const {
+    return lower_bound(sorted.begin(), sorted.end(), weight) - sorted.begin();
+}
+
+uint32_t WeightOrder::first_above(float weight) const {
+    return upper_bound(sorted.begin(), sorted.end(), weight) - sorted.begin();
+}
+
+RankFrontier::RankFrontier(const WeightOrder& order)
+    : _order(order), _tree(order.size() + 1, 0), _present(order.size(), 0), _size(0), _top(1) {
+    while (_top * 2 <= order.size()) {
+        _top *= 2;
+    }
+}
+
+void RankFrontier::add(uint32_t rank, int delta) {
+    for (size_t i = rank + 1; i < _tree.size(); i += i & (0 - i)) {
+        _tree[i] += delta;
+    }
+}
+
+size_t RankFrontier::prefix(uint32_t rank) const {
+    int32_t sum = 0;
+    for (size_t i = rank; i > 0; i -= i & (0 - i)) {
+        sum += _tree[i];
+    }
+    return sum;
+}
+
+// Descida binária pela árvore: maior posição com prefixo <= k
+uint32_t RankFrontier::select(size_t k) const {
+    size_t position = 0;
+    for (size_t step = _top; step > 0; step /= 2) {
+        if (position + step < _tree.size() && (size_t)_tree[position + step] <= k) {
+            position += step;
+            k -= _tree[position];
+        }
+    }
+    return position;
+}
+
+void RankFrontier::insert(uint32_t v) {
+    const uint32_t rank = _order.rank[v];
+    if (_present[rank]) {
+        return;
+    }
+    INSTRUMENT_COUNT(CANDIDATOS_INSERIDOS);
+    _present[rank] = 1;
+    _members.push_back(rank);
+    add(rank, 1);
+    ++_size;
+}
+
+void RankFrontier::erase(uint32_t v) {
+    const uint32_t rank = _order.rank[v];
+    if (!_present[rank]) {
+        return;
+    }
+    INSTRUMENT_COUNT(CANDIDATOS_REMOVIDOS);
+    _present[rank] = 0;
+    add(rank, -1);
+    --_size;
+}
+
+void RankFrontier::clear() {
+    for (uint32_t rank : _members) {
+        if (_present[rank]) {
+            _present[rank] = 0;
+            add(rank, -1);
+        }
+    }
+    _members.clear();
+    _size = 0;
+}
+
+uint32_t RankFrontier::nearest(float low, float high) const {
+    if (empty()) {
+        return NONE;
+    }
+    // Primeiro candidato com peso >= low e o último abaixo de low
+    const size_t below = prefix(_order.first_at_least(low));
+    uint32_t best = NONE;
+    float best_cost = numeric_limits<float>::infinity();
+    if (below < _size) {
+        const uint32_t rank = select(below);
+        best = _order.order[rank];
+        best_cost = max(0.0f, _order.sorted[rank] - high);
+    }
+    if (below > 0 && best_cost > 0) {
+        const uint32_t rank = select(below - 1);
+        if (low - _order.sorted[rank] < best_cost) {
+            best = _order.order[rank];
+        }
+    }
+    return best;
+}
+
+pair<size_t, size_t> RankFrontier::range(float low, float high) const {
+    const size_t first = prefix(_order.first_at_least(low));
+    if (high < low) {
+        return make_pair(first, first);
+    }
+    return make_pair(first, prefix(_order.first_above(high)));
+}
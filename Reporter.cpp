@@ -0,0 +1,135 @@
+#include "include/Reporter.hpp"
+#include "include/LocalSearch.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+AsyncWriter::AsyncWriter(ostream& out) : _out(out), _writing(false), _stop(false) {
+    _thread = thread(&AsyncWriter::loop, this);
+}
+
+AsyncWriter::~AsyncWriter() {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _stop = true;
+    }
+    _ready.notify_one();
+    _thread.join();
+}
+
+void AsyncWriter::write(string&& text) {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _queue.push_back(move(text));
+    }
+    _ready.notify_one();
+}
+
+void AsyncWriter::flush() {
+    unique_lock<mutex> lock(_mutex);
+    _drained.wait(lock, [this] { return _queue.empty() && !_writing; });
+}
+
+// Troca a fila inteira por uma vazia e escreve fora do lock, com um único flush por lote
+void AsyncWriter::loop() {
+    vector<string> batch;
+    unique_lock<mutex> lock(_mutex);
+    while (true) {
+        _ready.wait(lock, [this] { return _stop || !_queue.empty(); });
+        if (_queue.empty()) {
+            break;
+        }
+        batch.swap(_queue);
+        _writing = true;
+        lock.unlock();
+
+        for (const string& text : batch) {
+            _out << text;
+        }
+        _out.flush();
+        batch.clear();
+
+        lock.lock();
+        _writing = false;
+        _drained.notify_all();
+    }
+    _drained.notify_all();
+}
+
+Reporter::Reporter(const CSR& graph, Verbosity verbosity, ostream& out)
+    : _graph(graph), _verbosity(verbosity), _out(out) {
+    if (_verbosity >= Verbosity::PROGRESS) {
+        _writer.reset(new AsyncWriter(_out));
+    }
+}
+
+// O texto de cada iteração é montado na thread do worker e só a escrita vai
+// para o escritor assíncrono, então os workers nunca esperam pelo terminal
+IterationObserver Reporter::observer() {
+    if (_verbosity < Verbosity::ITERATIONS) {
+        return IterationObserver();
+    }
+    AsyncWriter* writer = _writer.get();
+    const CSR* graph = &_graph;
+    return [writer, graph](const IterationRecord& record, const LocalSearch& clusters) {
+        ostringstream text;
+        text << "Iteração " << record.iteracao + 1 << " (alpha = " << record.alpha << ")\n";
+        for (uint32_t i = 0; i < clusters.num_clusters(); ++i) {
+            text << "Subgrafo " << (i + 1) << " (Vértices: ";
+            for (uint32_t vertex : clusters.members(i)) {
+                text << graph->ids[vertex] << " ";
+            }
+            text << ") - Gap: " << clusters.gap(i) << "\n";
+        }
+        text << "Gap total: " << record.gap << "\n";
+        writer->write(text.str());
+    };
+}
+
+IncumbentObserver Reporter::incumbent_observer() {
+    if (!_writer) {
+        return IncumbentObserver();
+    }
+    AsyncWriter* writer = _writer.get();
+    return [writer](const IncumbentRecord& record) {
+        ostringstream text;
+        text << "[" << fixed << setprecision(3) << record.segundos << "s] iteração " << record.iteracao + 1
+             << ": novo melhor gap " << defaultfloat << setprecision(9) << record.gap << "\n";
+        writer->write(text.str());
+    };
+}
+
+void Reporter::report(const Solution& solution) {
+    flush();
+    if (_verbosity == Verbosity::SILENT) {
+        return;
+    }
+    if (!solution.ok()) {
+        cerr << "Erro: " << solution.erro << "\n";
+        return;
+    }
+    for (size_t i = 0; i < solution.subgraphs.size(); ++i) {
+        _out << "Subgrafo " << (i + 1) << " (Vértices: ";
+        for (size_t vertex : solution.subgraphs[i].vertices) {
+            _out << vertex << " ";
+        }
+        _out << ") - Gap: " << solution.gaps[i] << "\n";
+    }
+    _out << "Gap total calculado: " << solution.total_gap << "\n";
+    if (solution.limite_inferior >= 0) {
+        // A porcentagem é formatada à parte para não mudar a precisão de _out
+        ostringstream restante;
+        restante << fixed << setprecision(2) << gap_restante_pct(solution.total_gap, solution.limite_inferior);
+        _out << "Limite inferior: " << solution.limite_inferior << " (gap restante: " << restante.str() << "%)\n";
+    }
+    if (solution.otimo) {
+        _out << "Ótimo provado (branch-and-bound)\n";
+    }
+    _out << "Semente: " << solution.semente << endl;
+}
+
+void Reporter::flush() {
+    if (_writer) {
+        _writer->flush();
+    }
+}
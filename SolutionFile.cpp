@@ -0,0 +1,91 @@
+#include "include/SolutionFile.hpp"
+#include "include/Partition.hpp"
+#include "include/Validator.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+bool escreve_solucao(const CSR& g, const Solution& solution, const string& path) {
+    vector<uint32_t> label;
+    const string problem = rotulos_solucao(g, solution, label);
+    if (!problem.empty()) {
+        cerr << "Erro ao gravar a solução: " << problem << "\n";
+        return false;
+    }
+    ofstream output(path, ios::trunc);
+    if (!output) {
+        cerr << "Erro ao criar o arquivo da solução: " << path << "\n";
+        return false;
+    }
+    output << "vertices " << g.size() << "\nclusters " << solution.subgraphs.size() << "\ngap " << setprecision(9)
+           << solution.total_gap << "\n";
+    for (uint32_t c : label) {
+        output << (c == Partition::NONE ? 0 : c + 1) << '\n';
+    }
+    output.flush();
+    if (!output) {
+        cerr << "Erro ao gravar o arquivo da solução: " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+Solution le_solucao(const CSR& g, const string& path) {
+    Solution solution;
+    ifstream input(path);
+    if (!input) {
+        solution.erro = "Erro ao abrir o arquivo da solução: " + path + ".";
+        return solution;
+    }
+    string vertices_key, clusters_key, gap_key;
+    size_t n = 0, p = 0;
+    float gap = 0;
+    if (!(input >> vertices_key >> n >> clusters_key >> p >> gap_key >> gap) || vertices_key != "vertices" ||
+        clusters_key != "clusters" || gap_key != "gap") {
+        solution.erro = "Cabeçalho inválido no arquivo da solução: " + path + ".";
+        return solution;
+    }
+    if (n != g.size()) {
+        solution.erro = "A solução tem " + to_string(n) + " vértices e o grafo, " + to_string(g.size()) + ".";
+        return solution;
+    }
+    if (p == 0 || p > n) {
+        solution.erro = "Número de clusters inválido no arquivo da solução: " + to_string(p) + ".";
+        return solution;
+    }
+
+    solution.subgraphs.resize(p);
+    for (Subgraph& subgraph : solution.subgraphs) {
+        subgraph.max_weight = numeric_limits<float>::lowest();
+        subgraph.min_weight = numeric_limits<float>::max();
+        subgraph.total_weight = 0;
+    }
+    for (size_t v = 0; v < n; ++v) {
+        size_t c;
+        if (!(input >> c) || c > p) {
+            solution = Solution();
+            solution.erro = "Cluster inválido para o vértice " + to_string(v + 1) + " em " + path + ".";
+            return solution;
+        }
+        if (c == 0) continue;
+        Subgraph& subgraph = solution.subgraphs[c - 1];
+        subgraph.vertices.push_back(g.ids[v]);
+        subgraph.total_weight += g.weights[v];
+        subgraph.max_weight = max(subgraph.max_weight, g.weights[v]);
+        subgraph.min_weight = min(subgraph.min_weight, g.weights[v]);
+    }
+
+    // Gaps de cada subgrafo a partir dos pesos; o total fica o do cabeçalho, para
+    // que valida_solucao confira o gap declarado contra a soma recalculada
+    solution.gaps.assign(p, 0);
+    for (size_t c = 0; c < p; ++c) {
+        Subgraph& subgraph = solution.subgraphs[c];
+        if (subgraph.vertices.empty()) {
+            subgraph.max_weight = subgraph.min_weight = 0;
+            continue;
+        }
+        solution.gaps[c] = subgraph.max_weight - subgraph.min_weight;
+    }
+    solution.total_gap = gap;
+    return solution;
+}
@@ -0,0 +1,153 @@
+#include "include/TabuSearch.hpp"
+#include "include/Instrument.hpp"
+#include "include/Partition.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+typedef chrono::steady_clock Clock;
+
+// Tolerância para comparar gaps, como na LocalSearch
+static const float EPSILON = 1e-6f;
+
+TabuSearch::TabuSearch(const CSR& graph, const TabuConfig& config)
+    : _graph(graph), _config(config), _search(graph), _rng(config.seed), _iteration(0), _epoch(0),
+      _best_gap(numeric_limits<float>::max()) {}
+
+bool TabuSearch::tabu(uint32_t v, uint32_t c) const {
+    auto entry = _tabu_until.find((uint64_t)v * _search.num_clusters() + c);
+    return entry != _tabu_until.end() && entry->second >= _iteration;
+}
+
+void TabuSearch::torna_tabu(uint32_t v, uint32_t c) {
+    // Os itens vencidos só são apagados quando a tabela cresce demais
+    if (_tabu_until.size() > 4 * _graph.size() + 64) {
+        for (auto entry = _tabu_until.begin(); entry != _tabu_until.end(); ) {
+            entry = entry->second < _iteration ? _tabu_until.erase(entry) : next(entry);
+        }
+    }
+    const size_t tenure = _config.tenure + (_config.tenure_range > 0 ? _rng.uniform(_config.tenure_range) : 0);
+    _tabu_until[(uint64_t)v * _search.num_clusters() + c] = _iteration + tenure;
+}
+
+// Melhor realocação admissível a partir da partição atual. Só os movimentos que
+// empatam ou batem o melhor visto até ali passam pelo teste de tabu e de
+// conectividade; os empates são sorteados de modo uniforme (reservoir sampling).
+bool TabuSearch::melhor_movimento(float current_gap, uint32_t& vertex, uint32_t& to, float& delta, bool& aspiration) {
+    float best_delta = numeric_limits<float>::max();
+    size_t ties = 0;
+    _seen.resize(_search.num_clusters(), 0);
+    for (uint32_t v = 0; v < _graph.size(); ++v) {
+        const uint32_t from = _search.label(v);
+        if (from == Partition::NONE || _search.members(from).size() <= 2) continue;
+        ++_epoch;
+        for (const uint32_t* neighbor = _graph.begin(v); neighbor != _graph.end(v); ++neighbor) {
+            const uint32_t c = _search.label(*neighbor);
+            if (c == Partition::NONE || c == from || _seen[c] == _epoch) continue;
+            _seen[c] = _epoch;
+
+            const float move_delta = _search.relocate_delta(v, c);
+            if (move_delta > best_delta + EPSILON) continue;
+            const bool is_tabu = tabu(v, c);
+            const bool aspired = is_tabu && current_gap + move_delta < _best_gap - EPSILON;
+            if ((is_tabu && !aspired) || !_search.can_relocate(v, c)) continue;
+
+            if (move_delta < best_delta - EPSILON) {
+                best_delta = move_delta;
+                ties = 0;
+            }
+            if (_rng.uniform(++ties) == 0) {
+                vertex = v;
+                to = c;
+                delta = move_delta;
+                aspiration = aspired;
+            }
+        }
+    }
+    return ties > 0;
+}
+
+// Volta ao incumbente e aplica kick realocações aleatórias que mantêm a partição válida
+void TabuSearch::perturba() {
+    const size_t n = _graph.size();
+    const size_t kick = _config.kick > 0 ? _config.kick : max<size_t>(3, n / 50);
+    _search.load(_best);
+    size_t moved = 0;
+    for (size_t attempt = 0; moved < kick && attempt < 10 * kick; ++attempt) {
+        const uint32_t v = _rng.uniform(n);
+        const uint32_t from = _search.label(v);
+        const size_t degree = _graph.degree(v);
+        if (from == Partition::NONE || degree == 0) continue;
+        const uint32_t c = _search.label(_graph.begin(v)[_rng.uniform(degree)]);
+        if (c == Partition::NONE || c == from || !_search.can_relocate(v, c)) continue;
+        _search.relocate(v, c);
+        torna_tabu(v, from);
+        moved++;
+    }
+}
+
+void TabuSearch::run(const vector<vector<uint32_t>>& clusters, float stop_gap, Clock::time_point start,
+                     vector<IncumbentRecord>& improvements, TabuStats& stats) {
+    INSTRUMENT_PHASE("tabu");
+    const size_t n = _graph.size();
+    const size_t stagnation = _config.stagnation > 0 ? _config.stagnation : max<size_t>(100, n);
+    const size_t max_iter = _config.max_iter > 0 ? _config.max_iter : numeric_limits<size_t>::max();
+
+    _search.load(clusters);
+    _best = clusters;
+    _best_gap = _search.total_gap();
+    _iteration = 0;
+    _tabu_until.clear();
+    const IncumbentRecord first = { 0, _best_gap, chrono::duration<double>(Clock::now() - start).count() };
+    improvements.push_back(first);
+    if (_config.on_incumbent) {
+        _config.on_incumbent(first);
+    }
+
+    size_t last_improvement = 0;
+    for (_iteration = 1; _iteration <= max_iter; ++_iteration) {
+        if (stop_gap >= 0 && _best_gap <= stop_gap) {
+            break;
+        }
+        const double elapsed = chrono::duration<double>(Clock::now() - start).count();
+        if (_config.time_limit > 0 && elapsed >= _config.time_limit) {
+            break;
+        }
+        if (_iteration - last_improvement > stagnation) {
+            perturba();
+            stats.kicks++;
+            last_improvement = _iteration;
+        }
+
+        uint32_t v = 0, to = 0;
+        float delta = 0;
+        bool aspiration = false;
+        if (!melhor_movimento(_search.total_gap(), v, to, delta, aspiration)) {
+            // Nenhum movimento admissível: só resta perturbar
+            perturba();
+            stats.kicks++;
+            last_improvement = _iteration;
+            continue;
+        }
+        const uint32_t from = _search.label(v);
+        _search.relocate(v, to);
+        torna_tabu(v, from);
+        stats.iterations++;
+        INSTRUMENT_COUNT(ITERACOES);
+        stats.aspirations += aspiration;
+
+        const float current_gap = _search.total_gap();
+        if (current_gap < _best_gap - EPSILON) {
+            _best_gap = current_gap;
+            for (uint32_t c = 0; c < _best.size(); ++c) {
+                _best[c] = _search.members(c);
+            }
+            last_improvement = _iteration;
+            const IncumbentRecord record = { _iteration, current_gap, elapsed };
+            improvements.push_back(record);
+            if (_config.on_incumbent) {
+                _config.on_incumbent(record);
+            }
+        }
+    }
+}
@@ -0,0 +1,69 @@
+#include "include/ThreadPool.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+ThreadPool::ThreadPool(size_t threads) : _job(nullptr), _session(nullptr), _generation(0), _pending(0), _stop(false) {
+    for (size_t w = 1; w < max<size_t>(threads, 1); ++w) {
+        _threads.emplace_back(&ThreadPool::loop, this, w);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(_mutex);
+        _stop = true;
+    }
+    _start.notify_all();
+    for (thread& t : _threads) {
+        t.join();
+    }
+}
+
+void ThreadPool::run(const function<void(size_t)>& job) {
+    if (_threads.empty()) {
+        job(0);
+        return;
+    }
+    {
+        lock_guard<mutex> lock(_mutex);
+        _job = &job;
+        _session = sessao_atual();
+        _pending = _threads.size();
+        ++_generation;
+    }
+    _start.notify_all();
+
+    job(0);
+
+    unique_lock<mutex> lock(_mutex);
+    _done.wait(lock, [this] { return _pending == 0; });
+    _job = nullptr;
+}
+
+void ThreadPool::loop(size_t worker) {
+    size_t seen = 0;
+    while (true) {
+        const function<void(size_t)>* job;
+        SessaoInstrumentada* session;
+        {
+            unique_lock<mutex> lock(_mutex);
+            _start.wait(lock, [&] { return _stop || _generation != seen; });
+            if (_stop) return;
+            seen = _generation;
+            job = _job;
+            session = _session;
+        }
+
+        {
+            EscopoInstrumentado escopo(session);
+            (*job)(worker);
+        }
+
+        {
+            lock_guard<mutex> lock(_mutex);
+            --_pending;
+        }
+        _done.notify_one();
+    }
+}
@@ -0,0 +1,95 @@
+#include "include/Validator.hpp"
+#include "include/NodeIndex.hpp"
+#include "include/Partition.hpp"
+#include "include/defines.hpp"
+
+using namespace std;
+
+string rotulos_solucao(const CSR& g, const Solution& solution, vector<uint32_t>& label) {
+    const uint32_t NONE = Partition::NONE;
+    IdIndex<uint32_t, Partition::NONE> index_of;
+    for (uint32_t v = 0; v < g.size(); ++v) {
+        index_of.insert(g.ids[v], v);
+    }
+    label.assign(g.size(), NONE);
+    for (uint32_t c = 0; c < solution.subgraphs.size(); ++c) {
+        for (size_t id : solution.subgraphs[c].vertices) {
+            const uint32_t v = index_of.find(id);
+            if (v == NONE) {
+                return "O vértice " + to_string(id) + " do subgrafo " + to_string(c + 1) + " não existe no grafo.";
+            }
+            if (label[v] != NONE) {
+                return "O vértice " + to_string(id) + " aparece nos subgrafos " + to_string(label[v] + 1) + " e " + to_string(c + 1) + ".";
+            }
+            label[v] = c;
+        }
+    }
+    return "";
+}
+
+string valida_solucao(const CSR& g, const Solution& solution, size_t p, vector<uint32_t>* label) {
+    if (!solution.ok()) {
+        return "A heurística falhou: " + solution.erro;
+    }
+    if (solution.subgraphs.size() != p || solution.gaps.size() != p) {
+        return "A solução tem " + to_string(solution.subgraphs.size()) + " subgrafos e " + to_string(p) + " eram pedidos.";
+    }
+    vector<uint32_t> local_label;
+    vector<uint32_t>& cluster = label ? *label : local_label;
+    string problem = rotulos_solucao(g, solution, cluster);
+    if (!problem.empty()) {
+        return problem;
+    }
+
+    size_t covered = 0;
+    for (uint32_t c = 0; c < p; ++c) {
+        if (solution.subgraphs[c].vertices.size() < 2) {
+            return "O subgrafo " + to_string(c + 1) + " tem menos de dois vértices.";
+        }
+        covered += solution.subgraphs[c].vertices.size();
+    }
+    if (covered != g.size()) {
+        return to_string(g.size() - covered) + " vértices ficaram fora de todos os subgrafos.";
+    }
+
+    // Busca em largura dentro de cada subgrafo; cada aresta é vista duas vezes no total
+    const uint32_t NONE = Partition::NONE;
+    vector<uint32_t> first(p, NONE);
+    for (uint32_t v = 0; v < g.size(); ++v) {
+        if (first[cluster[v]] == NONE) first[cluster[v]] = v;
+    }
+    vector<char> seen(g.size(), 0);
+    vector<uint32_t> queue;
+    queue.reserve(g.size());
+    float total = 0;
+    for (uint32_t c = 0; c < p; ++c) {
+        queue.assign(1, first[c]);
+        seen[first[c]] = 1;
+        float lightest = g.weights[first[c]];
+        float heaviest = lightest;
+        for (size_t head = 0; head < queue.size(); ++head) {
+            const uint32_t v = queue[head];
+            lightest = min(lightest, g.weights[v]);
+            heaviest = max(heaviest, g.weights[v]);
+            for (const uint32_t* neighbor = g.begin(v); neighbor != g.end(v); ++neighbor) {
+                if (cluster[*neighbor] == c && !seen[*neighbor]) {
+                    seen[*neighbor] = 1;
+                    queue.push_back(*neighbor);
+                }
+            }
+        }
+        if (queue.size() != solution.subgraphs[c].vertices.size()) {
+            return "O subgrafo " + to_string(c + 1) + " não é conexo.";
+        }
+        const float gap = heaviest - lightest;
+        if (solution.gaps[c] != gap) {
+            return "O gap do subgrafo " + to_string(c + 1) + " é " + to_string(gap) + ", não " + to_string(solution.gaps[c]) + ".";
+        }
+        total += gap;
+    }
+    // A soma em float depende da ordem; a folga cobre só o arredondamento
+    if (fabs(solution.total_gap - total) > 1e-5f * max(1.0f, total)) {
+        return "O gap total é " + to_string(total) + ", não " + to_string(solution.total_gap) + ".";
+    }
+    return "";
+}
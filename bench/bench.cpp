@@ -0,0 +1,296 @@
+#include "../include/Batch.hpp"
+#include "../include/Generator.hpp"
+#include "../include/Graph.hpp"
+#include "../include/Reporter.hpp"
+#include "../include/defines.hpp"
+
+#include <filesystem>
+
+using namespace std;
+
+// Mede guloso, adaptativo e reativo sobre as instâncias dadas e sobre grafos
+// maiores gerados em _bench/, com aquecimento e repetições. Reporta mediana e
+// p95 por fase e, com --base, compara com uma execução salva antes.
+//
+// Arquivo de base (e saída de --salva): instancia,algoritmo,fase,mediana,p95
+
+namespace {
+
+typedef chrono::steady_clock Clock;
+
+const char* const FASES[] = { "carga", "construcao", "reparo", "busca_local", "saida", "total" };
+const size_t NUM_FASES = sizeof(FASES) / sizeof(FASES[0]);
+
+// Abaixo disso a diferença é ruído de medição, não regressão
+const double PISO_RUIDO = 0.002;
+
+struct BenchOptions {
+    size_t         repetitions = 5;
+    size_t         warmup = 1;
+    size_t         iterations = 50;
+    float          alpha = 0.3f;
+    double         tolerance = 0.10;
+    bool           generated = true;
+    string         save;
+    string         base;
+    vector<string> inputs;
+};
+
+struct Resultado {
+    string instance;
+    string algorithm;
+    double median[NUM_FASES];
+    double p95[NUM_FASES];
+};
+
+void mostra_uso(const char* program) {
+    cerr << "Uso: " << program << " [opções] <instância|diretório>...\n"
+         << "  --repeticoes n   execuções medidas por algoritmo e instância (padrão: 5)\n"
+         << "  --aquecimento n  execuções descartadas antes das medidas (padrão: 1)\n"
+         << "  --iteracoes n    iterações do reativo (padrão: 50)\n"
+         << "  --alpha x        alpha do adaptativo, entre 0 e 1 (padrão: 0.3)\n"
+         << "  --tolerancia x   aumento relativo da mediana total aceito (padrão: 0.10)\n"
+         << "  --sem-gerados    não gera nem mede os grafos maiores\n"
+         << "  --salva arquivo  grava as medianas e p95 como nova base\n"
+         << "  --base arquivo   compara com a base e sai com código 1 se houver regressão\n";
+}
+
+bool le_opcoes(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--sem-gerados") {
+            options.generated = false;
+            continue;
+        }
+        if (arg.compare(0, 2, "--") != 0) {
+            options.inputs.push_back(arg);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cerr << "Opção sem valor: " << arg << "\n";
+            return false;
+        }
+        string value = argv[++i];
+        bool valid = true;
+        if (arg == "--repeticoes") {
+            valid = le_numero(value, options.repetitions);
+            options.repetitions = max<size_t>(1, options.repetitions);
+        } else if (arg == "--aquecimento") {
+            valid = le_numero(value, options.warmup);
+        } else if (arg == "--iteracoes") {
+            valid = le_numero(value, options.iterations);
+        } else if (arg == "--alpha") {
+            valid = le_numero(value, options.alpha) && options.alpha >= 0 && options.alpha <= 1;
+        } else if (arg == "--tolerancia") {
+            valid = le_numero(value, options.tolerance);
+        } else if (arg == "--salva") {
+            options.save = value;
+        } else if (arg == "--base") {
+            options.base = value;
+        } else {
+            cerr << "Opção desconhecida: " << arg << "\n";
+            return false;
+        }
+        if (!valid) {
+            cerr << "Valor inválido para " << arg << ": " << value << "\n";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Instância das famílias de instancias/ em tamanho maior, gerada uma vez em dir
+string gera_grafo(const string& dir, size_t n, const string& family, uint64_t seed) {
+    GeneratorConfig config;
+    config.num_vertices = n;
+    config.family = family;
+    config.seed = seed;
+    const string path = dir + "/" + nome_instancia(config);
+    if (!ifstream(path) && !gera_instancia(config, path)) {
+        return string();
+    }
+    return path;
+}
+
+double mediana(vector<double> samples) {
+    sort(samples.begin(), samples.end());
+    size_t n = samples.size();
+    return n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2;
+}
+
+// Percentil 95 pelo posto mais próximo
+double p95(vector<double> samples) {
+    sort(samples.begin(), samples.end());
+    size_t rank = (size_t)ceil(0.95 * samples.size());
+    return samples[max<size_t>(rank, 1) - 1];
+}
+
+// Uma execução completa: carga da instância, a heurística e o relatório da
+// solução (formatado em memória). Devolve false quando a heurística falhou.
+bool executa(const string& path, const string& algorithm, const BenchOptions& options, double* phases) {
+    Clock::time_point start = Clock::now();
+    Graph graph(path);
+    graph.csr();
+    phases[0] = chrono::duration<double>(Clock::now() - start).count();
+
+    const size_t p = graph._num_clusters;
+    Solution solution;
+    if (algorithm == "guloso") {
+        solution = graph.guloso(p);
+    } else if (algorithm == "adaptativo") {
+        solution = graph.guloso_randomizado_adaptativo(p, options.alpha);
+    } else {
+        solution = graph.guloso_randomizado_adaptativo_reativo(p, options.iterations);
+    }
+    Clock::time_point report_start = Clock::now();
+    if (solution.ok()) {
+        ostringstream text;
+        Reporter(graph.csr(), Verbosity::SUMMARY, text).report(solution);
+    }
+    const double report_time = chrono::duration<double>(Clock::now() - report_start).count();
+    phases[NUM_FASES - 1] = chrono::duration<double>(Clock::now() - start).count();
+
+    const PhaseTimes& tempos = graph.tempos();
+    phases[1] = tempos.construcao;
+    phases[2] = tempos.reparo;
+    phases[3] = tempos.busca_local;
+    phases[4] = tempos.saida + report_time;
+    return solution.ok();
+}
+
+string chave(const string& instance, const string& algorithm, const string& phase) {
+    return instance + ',' + algorithm + ',' + phase;
+}
+
+// Lê a base salva: chave "instancia,algoritmo,fase" -> mediana
+bool le_base(const string& path, unordered_map<string, double>& base) {
+    ifstream input(path);
+    if (!input) {
+        cerr << "Erro ao abrir a base: " << path << "\n";
+        return false;
+    }
+    string line;
+    getline(input, line); // cabeçalho
+    while (getline(input, line)) {
+        size_t last = line.rfind(',');
+        size_t median_at = last == string::npos ? string::npos : line.rfind(',', last - 1);
+        double median = 0;
+        if (median_at == string::npos || !le_numero(line.substr(median_at + 1, last - median_at - 1), median)) {
+            cerr << "Linha inválida na base " << path << ": " << line << "\n";
+            return false;
+        }
+        base[line.substr(0, median_at)] = median;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!le_opcoes(argc, argv, options)) {
+        mostra_uso(argv[0]);
+        return 2;
+    }
+
+    vector<string> files = lista_instancias(options.inputs);
+    if (options.generated) {
+        const string dir = "_bench";
+        filesystem::create_directories(dir);
+        const string generated[] = { gera_grafo(dir, 500, "d03", 1), gera_grafo(dir, 1000, "pla", 1),
+                                     gera_grafo(dir, 5000, "pla", 2), gera_grafo(dir, 20000, "pla", 3) };
+        for (const string& path : generated) {
+            if (path.empty()) return 2;
+            files.push_back(path);
+        }
+    }
+    if (files.empty()) {
+        mostra_uso(argv[0]);
+        return 2;
+    }
+
+    unordered_map<string, double> base;
+    if (!options.base.empty() && !le_base(options.base, base)) {
+        return 2;
+    }
+
+    const vector<string> algorithms = { "guloso", "adaptativo", "reativo" };
+    vector<Resultado> results;
+    cout << fixed << setprecision(4);
+    cout << left << setw(24) << "instancia" << setw(12) << "algoritmo";
+    for (const char* phase : FASES) cout << right << setw(13) << phase;
+    cout << "   (mediana/p95 em s)\n";
+
+    for (const string& path : files) {
+        if (!ifstream(path)) {
+            cerr << "Erro ao abrir o arquivo de entrada: " << path << "\n";
+            continue;
+        }
+        const string instance = filesystem::path(path).filename().string();
+        for (const string& algorithm : algorithms) {
+            double phases[NUM_FASES];
+            for (size_t i = 0; i < options.warmup; ++i) {
+                executa(path, algorithm, options, phases);
+            }
+            vector<vector<double>> samples(NUM_FASES);
+            size_t failures = 0;
+            for (size_t i = 0; i < options.repetitions; ++i) {
+                failures += !executa(path, algorithm, options, phases);
+                for (size_t f = 0; f < NUM_FASES; ++f) samples[f].push_back(phases[f]);
+            }
+
+            Resultado result;
+            result.instance = instance;
+            result.algorithm = algorithm;
+            for (size_t f = 0; f < NUM_FASES; ++f) {
+                result.median[f] = mediana(samples[f]);
+                result.p95[f] = p95(samples[f]);
+            }
+            results.push_back(result);
+
+            cout << left << setw(24) << instance << setw(12) << algorithm << right;
+            for (size_t f = 0; f < NUM_FASES; ++f) cout << setw(13) << result.median[f];
+            if (failures) cout << "   (" << failures << " execução(ões) falharam)";
+            cout << '\n' << setw(36) << "";
+            for (size_t f = 0; f < NUM_FASES; ++f) cout << setw(13) << result.p95[f];
+            cout << endl;
+        }
+    }
+
+    if (!options.save.empty()) {
+        ofstream output(options.save);
+        output << "instancia,algoritmo,fase,mediana,p95\n" << setprecision(6) << fixed;
+        for (const Resultado& result : results) {
+            for (size_t f = 0; f < NUM_FASES; ++f) {
+                output << chave(result.instance, result.algorithm, FASES[f]) << ','
+                       << result.median[f] << ',' << result.p95[f] << '\n';
+            }
+        }
+        cout << "Base gravada em " << options.save << endl;
+    }
+
+    int status = 0;
+    if (!options.base.empty()) {
+        size_t regressions = 0;
+        for (const Resultado& result : results) {
+            auto it = base.find(chave(result.instance, result.algorithm, "total"));
+            if (it == base.end()) continue;
+            const double before = it->second;
+            const double now = result.median[NUM_FASES - 1];
+            if (now > before * (1 + options.tolerance) && now - before > PISO_RUIDO) {
+                cout << "REGRESSÃO " << result.instance << ' ' << result.algorithm << ": "
+                     << before << "s -> " << now << "s (+" << setprecision(1)
+                     << 100 * (now / before - 1) << "%)" << setprecision(4) << endl;
+                ++regressions;
+            } else if (now < before / (1 + options.tolerance) && before - now > PISO_RUIDO) {
+                cout << "melhora " << result.instance << ' ' << result.algorithm << ": "
+                     << before << "s -> " << now << "s" << endl;
+            }
+        }
+        cout << regressions << " regressão(ões) acima de " << setprecision(0)
+             << 100 * options.tolerance << "% em relação a " << options.base << endl;
+        status = regressions ? 1 : 0;
+    }
+
+    return status;
+}
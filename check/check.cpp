@@ -0,0 +1,84 @@
+#include "../include/Graph.hpp"
+#include "../include/Validator.hpp"
+#include "../include/defines.hpp"
+
+using namespace std;
+
+// Conferências rápidas com semente fixa (make check): as soluções das heurísticas
+// são válidas e repetíveis, e os pools de nós e arestas (Graph::alocacoes) não
+// pedem nada ao heap depois de montada a visão por ponteiros, nem durante as
+// heurísticas nem ao remover e recolocar um vértice. Sai com código 1 se algo falhar.
+
+namespace {
+
+size_t falhas = 0;
+
+void confere(bool ok, const string& descricao) {
+    cout << (ok ? "ok     " : "FALHA  ") << descricao << "\n";
+    if (!ok) falhas++;
+}
+
+void confere_solucao(Graph& graph, const Solution& solution, size_t p, const string& nome) {
+    const string problema = solution.ok() ? valida_solucao(graph.csr(), solution, p) : solution.erro;
+    confere(problema.empty(), nome + " devolve uma partição válida" + (problema.empty() ? "" : ": " + problema));
+}
+
+bool mesmos_contadores(const AllocationStats& a, const AllocationStats& b) {
+    return a.nos == b.nos && a.arestas == b.arestas && a.pedidos == b.pedidos && a.blocos == b.blocos;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        cerr << "Uso: " << argv[0] << " <instância>\n";
+        return 2;
+    }
+    Graph graph(argv[1]);
+    const size_t n = graph.csr().size();
+    const size_t m = graph.csr().num_arcs;
+    const size_t p = graph._num_clusters;
+    if (n == 0 || m == 0) {
+        cerr << "Instância vazia: " << argv[1] << "\n";
+        return 2;
+    }
+
+    // Aquecimento: a primeira consulta por id monta nós e arestas, um bloco por pool
+    const uint64_t first_id = graph.csr().ids[0];
+    graph.find_node(first_id);
+    const AllocationStats montado = graph.alocacoes();
+    confere(montado.nos == n && montado.arestas == m, "a visão por ponteiros tem todos os nós e arestas");
+    confere(montado.blocos == 2, "montar a visão por ponteiros pede um bloco por pool (" + to_string(montado.blocos) + ")");
+
+    // As heurísticas leem só a CSR
+    GraspConfig config;
+    config.seed = 7;
+    const Solution guloso = graph.guloso(p);
+    const Solution adaptativo = graph.guloso_randomizado_adaptativo(p, 0.3f, true, 7);
+    const Solution reativo = graph.guloso_randomizado_adaptativo_reativo(p, 50, config);
+    const Solution repetido = graph.guloso_randomizado_adaptativo_reativo(p, 50, config);
+    confere_solucao(graph, guloso, p, "guloso");
+    confere_solucao(graph, adaptativo, p, "adaptativo");
+    confere_solucao(graph, reativo, p, "reativo");
+    confere(reativo.total_gap == repetido.total_gap, "o reativo repete o gap com a mesma semente");
+    confere(mesmos_contadores(graph.alocacoes(), montado), "as heurísticas não alocam nós nem arestas");
+
+    // Remover e recolocar um vértice reaproveita os objetos liberados
+    vector<uint64_t> vizinhos;
+    for (const uint32_t* neighbor = graph.csr().begin(0); neighbor != graph.csr().end(0); ++neighbor) {
+        vizinhos.push_back(graph.csr().ids[*neighbor]);
+    }
+    const float peso = graph.csr().weights[0];
+    graph.remove_node(first_id);
+    graph.add_node(first_id, peso);
+    for (const uint64_t vizinho : vizinhos) {
+        graph.add_edge(first_id, vizinho);
+        graph.add_edge(vizinho, first_id);
+    }
+    const AllocationStats recolocado = graph.alocacoes();
+    confere(recolocado.nos == n && recolocado.arestas == m, "remover e recolocar um vértice restaura nós e arestas");
+    confere(recolocado.blocos == montado.blocos, "remover e recolocar um vértice não pede blocos novos");
+    confere_solucao(graph, graph.guloso_randomizado_adaptativo_reativo(p, 50, config), p, "reativo depois da edição");
+
+    return falhas == 0 ? 0 : 1;
+}
@@ -0,0 +1,27 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include "defines.hpp"
+
+#include <charconv>
+
+using namespace std;
+
+// Modo não interativo: roda combinações de algoritmo/alpha/semente sobre uma
+// lista de instâncias (arquivos ou diretórios) e escreve uma linha CSV ou JSON
+// por execução. Cada instância é carregada uma única vez.
+int executa_lote(int argc, char* argv[]);
+
+// Lê um valor numérico de opção da linha de comando; false se o texto não for
+// inteiro um número do tipo (vazio, sobra, sinal em sem sinal, fora da faixa)
+template <typename T>
+bool le_numero(const string& text, T& value) {
+    const char* end = text.data() + text.size();
+    const from_chars_result result = from_chars(text.data(), end, value);
+    return !text.empty() && result.ec == errc() && result.ptr == end;
+}
+
+// Expande diretórios nos arquivos .txt/.bin contidos neles (em ordem alfabética)
+vector<string> lista_instancias(const vector<string>& inputs);
+
+#endif  //BATCH_HPP
@@ -0,0 +1,86 @@
+#ifndef BRANCH_AND_BOUND_HPP
+#define BRANCH_AND_BOUND_HPP
+
+#include "CSR.hpp"
+#include "RankFrontier.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Parâmetros do modo exato (Graph::exato)
+struct ExactConfig
+{
+    size_t   threads = 1;
+    double   time_limit = 0;             // segundos; 0 = sem limite
+    uint64_t node_limit = 0;             // nós da árvore; 0 = sem limite
+    size_t   heuristic_iterations = 200; // iterações do reativo para o incumbente inicial; 0 = sem
+    uint64_t seed = 1;                   // semente do reativo
+};
+
+struct ExactStats
+{
+    uint64_t nos = 0;        // nós visitados
+    uint64_t roubos = 0;     // subárvores tiradas da fila de outro worker
+    bool     provado = false; // a árvore foi percorrida inteira
+    double   limite = 0;     // limite inferior ao final (= ótimo quando provado)
+    double   tempo = 0;      // segundos na árvore, sem a heurística
+};
+
+struct SearchWorker;
+
+// Branch-and-bound sobre a atribuição vértice -> cluster na ordem crescente de
+// peso. Nessa ordem o mínimo de um cluster é o peso de quem o abriu e o gap
+// cresce em w(v) - último peso do cluster a cada vértice que ele recebe.
+//
+// Poda:
+//  - limite: cada vértice ainda livre aumenta o gap de quem o recebe em pelo
+//    menos a diferença para o peso anterior na ordem, exceto os p - k que ainda
+//    vão abrir clusters (descontam-se as p - k maiores diferenças);
+//  - contagem: vértices livres suficientes para completar os clusters unitários
+//    e abrir os que faltam com dois vértices cada;
+//  - conectividade: todo cluster precisa continuar conexo em G[cluster + livres]
+//    e componentes livres longe de todos os clusters precisam de clusters novos.
+//    Depois de uma atribuição só se refaz a verificação inteira quando o vértice
+//    pode ter sido caminho de outro cluster (dois ou mais vizinhos livres ou em
+//    outros clusters), é vizinho de um cluster unitário, abre um cluster ou só
+//    alcança o seu cluster pelos livres.
+//
+// Paralelismo: cada worker tem uma fila de subárvores (prefixos da atribuição).
+// Quem está sem trabalho rouba a subárvore mais antiga (mais rasa) de outro
+// worker, e um worker em busca em profundidade doa os irmãos ainda não
+// explorados enquanto houver alguém ocioso.
+class BranchAndBound
+{
+public:
+    BranchAndBound(const CSR& graph, const WeightOrder& order, size_t num_clusters);
+
+    // Procura uma partição com soma dos gaps menor que incumbent. Devolve true
+    // se encontrou; a melhor fica em clusters(). stats.provado diz se a busca
+    // terminou (sem achar nada, o incumbente é ótimo).
+    bool run(double incumbent, const ExactConfig& config, ExactStats& stats);
+
+    const vector<vector<uint32_t>>& clusters() const { return _best_clusters; }
+    double best() const { return _best; }
+
+private:
+    void explora(SearchWorker& worker);
+    bool viavel(SearchWorker& worker);
+    bool viavel_local(SearchWorker& worker, uint32_t v, uint32_t c, bool opened);
+    double resto(size_t position, size_t opened) const;
+    void registra(SearchWorker& worker);
+
+    const CSR&              _graph;
+    const size_t            _n;
+    const size_t            _p;
+    const vector<uint32_t>& _order;  // vértices em ordem crescente de peso (WeightOrder::order)
+    vector<double>          _weight; // peso de _order[s]
+    vector<double>          _suffix; // soma das diferenças _weight[s] - _weight[s - 1] de s em diante
+    vector<double>          _top;    // (n + 1) x (p + 1): soma das j maiores diferenças de s em diante
+
+    mutex                    _best_mutex;
+    atomic<double>           _incumbent;
+    double                   _best;
+    vector<vector<uint32_t>> _best_clusters;
+};
+
+#endif  //BRANCH_AND_BOUND_HPP
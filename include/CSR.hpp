@@ -0,0 +1,54 @@
+#ifndef GRAFO_BASICO_CSR_H
+#define GRAFO_BASICO_CSR_H
+
+#include "MappedFile.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Adjacência compacta (compressed sparse row). Os vértices recebem índices
+// densos 0..n-1; os vizinhos do vértice v ficam em targets[offsets[v] .. offsets[v+1]).
+//
+// Os ponteiros apontam ou para o armazenamento próprio (CSR montada em memória)
+// ou direto para um arquivo binário mapeado, sem cópia.
+struct CSR
+{
+    size_t          num_vertices = 0;
+    size_t          num_arcs = 0;
+    const uint64_t* offsets = nullptr; // n + 1 posições
+    const uint32_t* targets = nullptr; // índices densos dos vizinhos
+    const float*    weights = nullptr; // peso de cada vértice, paralelo a ids
+    const uint64_t* ids = nullptr;     // id original de cada índice denso
+
+    // Arrays donos dos dados quando a CSR é montada em memória
+    struct Storage
+    {
+        vector<uint64_t> offsets;
+        vector<uint32_t> targets;
+        vector<float>    weights;
+        vector<uint64_t> ids;
+    } storage;
+    shared_ptr<MappedFile> mapping; // mantém o arquivo mapeado vivo
+
+    CSR() = default;
+    CSR(const CSR&) = delete;
+    CSR& operator=(const CSR&) = delete;
+
+    // Passa a apontar para storage (depois de preenchê-lo)
+    void attach_storage() {
+        mapping.reset();
+        num_vertices = storage.weights.size();
+        num_arcs = storage.targets.size();
+        offsets = storage.offsets.data();
+        targets = storage.targets.data();
+        weights = storage.weights.data();
+        ids = storage.ids.data();
+    }
+
+    size_t size() const { return num_vertices; }
+    size_t degree(size_t v) const { return offsets[v + 1] - offsets[v]; }
+    const uint32_t* begin(size_t v) const { return targets + offsets[v]; }
+    const uint32_t* end(size_t v) const { return targets + offsets[v + 1]; }
+};
+
+#endif  //GRAFO_BASICO_CSR_H
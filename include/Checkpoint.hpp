@@ -0,0 +1,85 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include "ElitePool.hpp"
+#include "Solution.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Estado de um worker do reativo no fim de um bloco (os acumuladores por alpha
+// do worker estão zerados nesse ponto e não entram)
+struct GraspWorkerState
+{
+    uint64_t                rng[4];
+    float                   best_gap;
+    uint64_t                best_iter;
+    uint64_t                executed;
+    vector<Subgraph>        best_subgraphs;
+    vector<IterationRecord> trace;
+};
+
+// Tudo o que o GRASP reativo precisa para continuar depois do bloco que
+// termina em next_block - 1 exatamente como se não tivesse parado. Os
+// primeiros campos identificam a execução: só se retoma com os mesmos valores.
+struct GraspCheckpoint
+{
+    uint64_t      num_vertices = 0;
+    uint64_t      num_clusters = 0;
+    uint64_t      threads = 0;
+    uint64_t      seed = 0;
+    uint64_t      update_period = 0;
+    vector<float> alphas;
+    uint64_t      elite_size = 0;
+    float         elite_diversity = 0;
+
+    uint64_t                 next_block = 0; // primeira iteração ainda não executada
+    double                   elapsed = 0;    // segundos já rodados, para o limite de tempo e as melhoras
+    float                    incumbent = 0;
+    float                    published = 0;  // último gap publicado em melhorias
+    vector<float>            gaps_per_alpha;
+    vector<uint64_t>         counts_per_alpha;
+    vector<float>            probabilities;
+    vector<IncumbentRecord>  improvements;
+    vector<GraspWorkerState> workers;
+    vector<EliteSolution>    elite;
+};
+
+// Formato binário do checkpoint: "TDGRAFOC", versão e ordem de bytes, seguidos
+// dos campos na ordem da struct; vetores levam o tamanho (uint64) na frente.
+// Tudo na ordem de bytes da máquina, como o formato binário das instâncias.
+const uint32_t CHECKPOINT_VERSION = 2;
+
+string serializa_checkpoint(const GraspCheckpoint& checkpoint);
+// false se o arquivo não pôde ser lido ou não é um checkpoint desta versão
+bool le_checkpoint(const string& path, GraspCheckpoint& checkpoint);
+
+// Serializa e grava checkpoints a partir de uma thread própria, para que o
+// reativo só pague a cópia do estado. Cada gravação vai para path.tmp e depois
+// é renomeada para path, então o arquivo nunca fica pela metade. Se um
+// checkpoint chega antes de o anterior ser gravado, só o mais novo é gravado.
+class CheckpointWriter
+{
+public:
+    explicit CheckpointWriter(const string& path);
+    ~CheckpointWriter(); // grava o que estiver pendente antes de sair
+
+    void write(GraspCheckpoint&& checkpoint);
+    void flush(); // espera até o último checkpoint enviado estar no disco
+
+private:
+    void loop();
+    bool grava(const string& data);
+
+    const string       _path;
+    mutex              _mutex;
+    condition_variable _ready;
+    condition_variable _drained;
+    GraspCheckpoint    _pending;
+    bool               _has_pending;
+    bool               _writing;
+    bool               _stop;
+    thread             _thread;
+};
+
+#endif  //CHECKPOINT_HPP
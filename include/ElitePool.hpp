@@ -0,0 +1,114 @@
+#ifndef ELITE_POOL_HPP
+#define ELITE_POOL_HPP
+
+#include "LocalSearch.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Partição guardada no pool de elite: o cluster de cada vértice (Partition::NONE
+// para os que ficaram de fora), o gap total e a iteração que a produziu
+struct EliteSolution
+{
+    vector<uint32_t> label;
+    float            gap;
+    uint64_t         iteration;
+};
+
+// Os rótulos dos clusters são arbitrários, então duas partições só se comparam
+// depois de casar os clusters de uma com os da outra. O casamento é guloso pelos
+// pares com mais vértices em comum (O(n log n)); a distância é o número de
+// vértices atribuídos nas duas que ficam em clusters diferentes depois dele.
+class PartitionMatch
+{
+public:
+    // Distância entre a e b; depois da chamada, mapped(c) é o cluster de a casado
+    // com o cluster c de b (NONE se sobrou)
+    size_t match(const vector<uint32_t>& a, const vector<uint32_t>& b, size_t num_clusters);
+    uint32_t mapped(uint32_t c) const { return _b_to_a[c]; }
+
+private:
+    vector<uint64_t> _keys;   // a(v) * p + b(v) de cada vértice atribuído nas duas
+    vector<pair<uint32_t, uint64_t>> _pairs; // (vértices em comum, chave)
+    vector<uint32_t> _b_to_a;
+    vector<char>     _a_used;
+};
+
+// Pool das melhores partições, com um mínimo de distância entre elas para não
+// encher de cópias da mesma solução. Uma candidata entra se o pool tem vaga ou
+// se é melhor que a pior; se ficar perto demais de algum membro, só entra no
+// lugar dele e só se for melhor que ele.
+//
+// No reativo o pool só muda entre blocos de iterações, pela thread principal e
+// na ordem das iterações; durante o bloco as threads apenas leem, sem lock, e o
+// resultado continua dependendo só da semente e do número de threads.
+class ElitePool
+{
+public:
+    ElitePool(size_t capacity, size_t min_distance, size_t num_clusters);
+
+    // Devolve true se a candidata entrou
+    bool offer(const vector<uint32_t>& label, float gap, uint64_t iteration);
+    // Vale a pena copiar uma candidata com esse gap para oferecer depois?
+    bool accepts(float gap) const;
+
+    const vector<EliteSolution>& members() const { return _members; }
+    vector<EliteSolution>& members() { return _members; }
+    size_t size() const { return _members.size(); }
+    bool empty() const { return _members.empty(); }
+
+private:
+    size_t                _capacity;
+    size_t                _min_distance;
+    size_t                _num_clusters;
+    vector<EliteSolution> _members;
+    PartitionMatch        _match;
+};
+
+// Path-relinking da partição carregada na busca local em direção a uma partição
+// guia: a cada passo realoca, entre os vértices que ainda estão fora do cluster
+// (casado) em que a guia os põe, o de menor variação de gap cujo movimento
+// mantém os clusters conexos e com dois vértices (LocalSearch::can_relocate).
+// O caminho para quando não resta movimento possível, e a busca volta ao melhor
+// ponto visitado, que pode ser a própria partição de partida.
+//
+// Os candidatos ficam num heap pela variação do gap. Como a variação de um
+// movimento só muda quando o cluster de origem ou o de destino muda, cada item
+// guarda a versão dos dois clusters e só é reavaliado ao sair do heap com versão
+// velha; um movimento impossível espera numa lista dos dois clusters até um
+// deles mudar. Cada passo custa O(log d) mais os itens desses dois clusters.
+class PathRelinker
+{
+public:
+    // Devolve o gap do melhor ponto do caminho, onde a busca local fica. No prazo
+    // o caminho é interrompido e a busca volta ao melhor ponto visto até ali.
+    float run(LocalSearch& search, const vector<uint32_t>& guide, Deadline deadline = Deadline::max());
+
+private:
+    struct Candidate {
+        float    delta;
+        uint32_t index;      // posição em _pending
+        uint32_t generation; // itens de gerações antigas são descartados
+        uint32_t from_version;
+        uint32_t to_version;
+
+        // Heap de mínimo por (delta, index), para não depender da ordem de inserção
+        bool operator<(const Candidate& other) const {
+            return delta != other.delta ? delta > other.delta : index > other.index;
+        }
+    };
+
+    void push(const LocalSearch& search, uint32_t i);
+
+    PartitionMatch                           _match;
+    vector<uint32_t>                         _pending;    // vértices fora do cluster da guia
+    vector<uint32_t>                         _target;     // cluster de destino de cada um
+    vector<uint32_t>                         _generation;
+    vector<char>                             _done;
+    vector<uint32_t>                         _version;    // mudanças de cada cluster no caminho
+    vector<vector<pair<uint32_t, uint32_t>>> _waiting;    // (item, geração) impossíveis, por cluster
+    vector<Candidate>                        _heap;
+    vector<pair<uint32_t, uint32_t>>         _moves;      // (vértice, cluster de origem), para voltar ao melhor ponto
+};
+
+#endif  //ELITE_POOL_HPP
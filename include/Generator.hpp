@@ -0,0 +1,43 @@
+#ifndef GENERATOR_HPP
+#define GENERATOR_HPP
+
+#include "defines.hpp"
+
+using namespace std;
+
+// Instância sintética no formato de instancias/ (ou no binário de Loader.hpp),
+// seguindo as famílias dos nomes dos arquivos:
+//   d03, d06  grafo aleatório em que cada aresta existe com probabilidade 1/3
+//             ou 2/3 (as densidades medidas nas instâncias), mais uma aresta de
+//             cada vértice para um de índice maior, o que o deixa conexo
+//   pla       grade triangulada (planar, grau médio perto de 6) com vértices
+//             numerados em ordem aleatória; algumas arestas saem até o grau pedido
+// Os pesos são inteiros em [1, peso máximo], crescentes com o id do vértice como
+// nas instâncias. Tudo depende só da semente, e a escrita é em fluxo: o arquivo
+// de texto pode ser maior que a memória; o binário usa um buffer de adjacências
+// limitado por memory_mb e gera as arestas de novo a cada passada.
+struct GeneratorConfig
+{
+    size_t   num_vertices = 1000;
+    string   family = "d03";       // d03, d06 ou pla
+    double   density = -1;         // famílias d: probabilidade de cada aresta; negativo = a da família
+    double   degree = -1;          // grau médio: nas famílias d substitui a densidade; em pla até 6 (negativo = 5.7)
+    string   clusters = "p2";      // p1 = ln n, p2 = raiz de n, p3 = n / ln n (como nas instâncias) ou um número
+    string   weights = "uniforme"; // uniforme, exponencial ou loguniforme
+    double   max_weight = 0;       // 0 = n
+    uint64_t seed = 1;
+    bool     binary = false;
+    size_t   memory_mb = 1024;     // buffer das adjacências na escrita binária
+};
+
+// Nome do arquivo no padrão das instâncias, por exemplo n1000d03p2i1.txt
+string nome_instancia(const GeneratorConfig& config);
+
+// Grava a instância em path; false (com a mensagem em cerr) se a configuração
+// for inválida ou a escrita falhar
+bool gera_instancia(const GeneratorConfig& config, const string& path);
+
+// Modo --gera da linha de comando
+int executa_gerador(int argc, char* argv[]);
+
+#endif  //GENERATOR_HPP
@@ -1,21 +1,38 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
+#include "BranchAndBound.hpp"
+#include "CSR.hpp"
+#include "Grasp.hpp"
+#include "LowerBound.hpp"
 #include "Node.hpp"
+#include "NodeIndex.hpp"
+#include "Pool.hpp"
+#include "RankFrontier.hpp"
+#include "Solution.hpp"
+#include "TabuSearch.hpp"
 #include "defines.hpp"
 
 using namespace std;
 
-// Declaração da estrutura Subgraph
-struct Subgraph {
-    vector<size_t> vertices; // Vértices no subgrafo
-    float max_weight;             // Maior peso no subgrafo
-    float min_weight;             // Menor peso no subgrafo
-    float total_weight;
+struct GraspWorker;
 
-    Subgraph() : max_weight(0), min_weight(0) {}
+// Tempo gasto em cada fase da última heurística executada, em segundos.
+// No reativo os tempos são somados entre as threads.
+struct PhaseTimes {
+    double construcao = 0;
+    double reparo = 0;      // ajustes de subgrafos com menos de 2 vértices e segunda fase
+    double busca_local = 0;
+    double saida = 0;       // montagem da Solution (ids originais e gaps)
 };
 
+// Contadores dos pools de nós e arestas da visão por ponteiros
+struct AllocationStats {
+    size_t nos;     // nós vivos
+    size_t arestas; // arestas vivas
+    size_t pedidos; // nós e arestas alocados desde a criação do grafo
+    size_t blocos;  // blocos pedidos ao heap pelos dois pools
+};
 
 class Graph
 {
@@ -23,6 +40,7 @@ public:
     /*Assinatura dos métodos básicos para o funcionamento da classe*/
 
     Graph(ifstream& instance);
+    explicit Graph(const string& path);
     Graph();
     ~Graph();
     size_t _num_clusters; 
@@ -32,14 +50,32 @@ public:
     void add_edge(size_t node_id_1, size_t node_id_2, float weight = 0);
     void print_graph(ofstream& output_file);
     void print_graph();
+    bool salva_binario(const string& path);
     int conected(size_t node_id_1, size_t node_id_2);
     // Funcoes do problema
     float gap(const Subgraph& subgraph);
     Node* find_node(size_t id);
-    float guloso(size_t p);
-    float guloso_randomizado_adaptativo(size_t p, float alpha);
-    float guloso_randomizado_adaptativo_reativo(size_t p, size_t max_iter);
+    Solution guloso(size_t p, bool busca_local = true, uint64_t seed = 1);
+    Solution guloso_randomizado_adaptativo(size_t p, float alpha, bool busca_local = true, uint64_t seed = 1);
+    Solution guloso_randomizado_adaptativo_reativo(size_t p, size_t max_iter, const GraspConfig& config = GraspConfig(), AlphaStats* stats = nullptr);
+    // Ótimo por branch-and-bound, partindo do melhor resultado do reativo
+    Solution exato(size_t p, const ExactConfig& config = ExactConfig(), ExactStats* stats = nullptr);
+    // Busca tabu com perturbações (busca local iterada) a partir do guloso ou de initial
+    Solution busca_tabu(size_t p, const TabuConfig& config = TabuConfig(), TabuStats* stats = nullptr, const Solution* initial = nullptr);
     bool verifica_conexo(const vector<size_t>& vertices, size_t new_vertex);
+    // Tempos da última heurística que terminou (cópia: outra thread pode estar escrevendo)
+    PhaseTimes tempos() const;
+    AllocationStats alocacoes() const;
+    // Limite inferior da soma dos gaps com p clusters (guardado até o grafo mudar)
+    const LowerBound& limite_inferior(size_t p);
+    // Vértices em ordem crescente de peso e o posto de cada um (guardado até o grafo mudar)
+    const WeightOrder& ordem_por_peso();
+    // Visão compacta da adjacência usada pelas heurísticas (reconstruída sob demanda)
+    const CSR& csr();
+    // Calcula de uma vez a CSR, o limite inferior de p e a ordem por peso. Depois
+    // disso as heurísticas e o exato com esse p só leem o grafo e podem rodar ao
+    // mesmo tempo em threads diferentes (modo em lote com --trabalhos)
+    void prepara(size_t p);
 
 private:
     size_t _number_of_nodes;
@@ -49,8 +85,30 @@ private:
     bool   _weighted_nodes;
     Node  *_first;
     Node  *_last;
+    NodeIndex _index;
+    Pool<Node> _node_pool;
+    Pool<Edge> _edge_pool;
+    bool   _lists_valid; // listas encadeadas refletem a CSR carregada
+    CSR    _csr;
+    bool   _csr_valid;
+
+    void carrega(const char* data, size_t size, const shared_ptr<MappedFile>& file);
+    void materializa_listas();
+
+    void build_csr();
+    bool conectado(size_t index_1, size_t index_2, vector<char>& visited);
+    void monta_subgrafo(const vector<uint32_t>& members, Subgraph& subgraph);
+    void calcula_gaps(Solution& solution);
+    void registra_tempos(const PhaseTimes& tempos);
+    bool constroi_guloso(size_t p, uint64_t seed, vector<vector<uint32_t>>& clusters, PhaseTimes& tempos);
+    bool constroi_reativo(size_t p, float alpha, GraspWorker& worker);
     // Adicione um vetor para armazenar os subgrafos
     vector<Subgraph> subgraphs;
+    PhaseTimes _tempos;
+    mutable mutex _tempos_mutex;
+    LowerBound _bound;
+    size_t     _bound_p; // p de _bound; 0 = não calculado
+    WeightOrder _ordem;  // vazia = não calculada
 };
 
 #endif  //GRAPH_HPP
\ No newline at end of file
@@ -0,0 +1,56 @@
+#ifndef GRASP_HPP
+#define GRASP_HPP
+
+#include "Solution.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+class LocalSearch;
+
+// Chamado ao fim de cada iteração válida com a partição já melhorada pela busca
+// local. Com várias threads pode ser chamado em paralelo e fora de ordem.
+typedef function<void(const IterationRecord& record, const LocalSearch& clusters)> IterationObserver;
+
+// Chamado a cada melhora estrita do incumbente, nunca em paralelo consigo mesmo
+typedef function<void(const IncumbentRecord& record)> IncumbentObserver;
+
+// Parâmetros do GRASP reativo. Para a mesma semente e o mesmo número de
+// threads o resultado é sempre o mesmo.
+struct GraspConfig
+{
+    size_t        threads = 1;        // workers; dentro de um bloco a iteração i roda no worker i % threads
+    uint64_t      seed = 1;           // semente base; o worker w usa Random(seed).split(w)
+    vector<float> alphas = {0.05f, 0.1f, 0.2f, 0.3f, 0.5f};
+    size_t        update_period = 50; // iterações entre recálculos das probabilidades
+    size_t        block_per_thread = 8; // mínimo de iterações de cada worker entre barreiras: o bloco
+                                       // tem max(update_period, block_per_thread * threads) iterações
+    float         amplification = 10; // expoente delta de q_i = (melhor / média_i)^delta
+    bool          local_search = true; // aplicar a busca local após cada construção
+    size_t        elite_size = 10;     // partições no pool de elite; 0 = sem pool e sem path-relinking
+    float         elite_diversity = 0.05f; // distância mínima entre membros do pool, em fração dos vértices
+    double        time_limit = 0;      // segundos; 0 = sem limite
+    float         target_gap = -1;     // para assim que o gap ficar <= alvo; negativo = sem alvo
+    bool          stop_at_bound = true; // para se o incumbente atingir o limite inferior (ótimo provado)
+    size_t        check_period = 1;    // iterações de cada worker entre consultas ao relógio;
+                                       // aumentar só se cada iteração levar poucos microssegundos
+    string        checkpoint;          // arquivo de checkpoint; vazio = sem checkpoints
+    double        checkpoint_interval = 60; // segundos entre checkpoints, gravados no fim de um bloco
+    bool          resume = false;      // continuar do checkpoint, se o arquivo existir (mesma semente,
+                                       // threads, alphas e update_period); o resultado é o mesmo
+                                       // de uma execução sem interrupção
+    IterationObserver on_iteration;    // opcional; as heurísticas em si não fazem E/S
+    IncumbentObserver on_incumbent;    // opcional
+};
+
+// Estatísticas por alpha ao final da execução do GRASP reativo
+struct AlphaStats
+{
+    vector<float>  alphas;
+    vector<float>  probabilities; // distribuição usada no último bloco de iterações
+    vector<size_t> counts;        // construções válidas feitas com cada alpha
+    vector<float>  average_gap;   // gap médio dessas construções (0 se nunca usado)
+    size_t         iterations = 0; // iterações executadas (menos que max_iter se o tempo acabou)
+};
+
+#endif  //GRASP_HPP
@@ -0,0 +1,154 @@
+#ifndef INSTRUMENT_HPP
+#define INSTRUMENT_HPP
+
+#include "defines.hpp"
+
+using namespace std;
+
+// Instrumentação dos caminhos quentes, ligada só em tempo de compilação
+// (make INSTRUMENT=1, que define INSTRUMENT). Desligada, as macros somem e as
+// classes ficam vazias: o binário é o mesmo de antes.
+//
+// Os contadores são por thread, sem atomics: cada thread soma nos seus e os
+// descarrega na sessão da execução ao sair do escopo dela. A ThreadPool leva a
+// sessão de quem chama run() para os workers, então as threads do reativo e do
+// exato contam para a execução certa mesmo com vários trabalhos simultâneos.
+enum Contador {
+    BUSCAS_ID,              // IdIndex::find (find_node e as leituras por id)
+    TESTES_CONECTIVIDADE,   // can_relocate e trocas na busca local
+    ARTICULACOES,           // recálculos dos pontos de articulação de um cluster
+    VISITAS_DFS,            // vértices visitados por DFS/BFS (guloso, reparo, busca local)
+    CANDIDATOS_INSERIDOS,   // entradas na fronteira ou na pilha do DFS
+    CANDIDATOS_REMOVIDOS,
+    REPAROS,                // Partition::repair
+    MOVIMENTOS,             // realocações e trocas aplicadas
+    ITERACOES,              // iterações do reativo, movimentos da tabu, nós do exato, uma por construção
+    NUM_CONTADORES
+};
+
+#ifdef INSTRUMENT
+
+extern const char* const NOMES_CONTADORES[NUM_CONTADORES];
+extern thread_local uint64_t contadores_locais[NUM_CONTADORES];
+
+#define INSTRUMENT_COUNT(contador) (++contadores_locais[contador])
+#define INSTRUMENT_ADD(contador, n) (contadores_locais[contador] += (n))
+#define INSTRUMENT_CONCAT_(a, b) a##b
+#define INSTRUMENT_CONCAT(a, b) INSTRUMENT_CONCAT_(a, b)
+#define INSTRUMENT_PHASE(nome) FaseMedida INSTRUMENT_CONCAT(_fase_, __LINE__)(nome)
+#define INSTRUMENT_PHASE_BEGIN(fase, nome) FaseMedida fase(nome)
+#define INSTRUMENT_PHASE_END(fase) fase.encerra()
+
+static constexpr bool INSTRUMENTACAO = true;
+
+// Tempo acumulado de uma fase (o nome é um literal)
+struct FaseTotal {
+    const char* nome;
+    size_t      chamadas;
+    double      segundos;
+};
+
+// Intervalo para o trace do Chrome, em microssegundos desde o início da sessão
+struct EventoTrace {
+    const char* nome;
+    uint32_t    thread;
+    double      inicio;
+    double      duracao;
+};
+
+// Tudo o que as threads de uma execução contaram
+class SessaoInstrumentada
+{
+public:
+    // Com trace, guarda também cada intervalo medido, até max_eventos
+    explicit SessaoInstrumentada(bool trace, size_t max_eventos = 1 << 20);
+
+    uint64_t contador(Contador c) const { return _contadores[c]; }
+    const vector<FaseTotal>& fases() const { return _fases; }
+
+    // Objeto JSON com contadores, fases e iterações por segundo (segundos = duração da execução)
+    void escreve_resumo(ostream& out, double segundos) const;
+    // Arquivo no formato de eventos do Chrome (chrome://tracing, Perfetto)
+    bool escreve_trace(const string& path) const;
+
+private:
+    friend class EscopoInstrumentado;
+    friend class FaseMedida;
+    void acumula(const uint64_t* contadores, const vector<FaseTotal>& fases, vector<EventoTrace>& eventos,
+                 size_t descartados);
+
+    const bool                  _trace;
+    const size_t                _max_eventos;
+    const chrono::steady_clock::time_point _inicio;
+    mutex                       _mutex;
+    uint64_t                    _contadores[NUM_CONTADORES];
+    vector<FaseTotal>           _fases;
+    vector<EventoTrace>         _eventos;
+    size_t                      _descartados;
+};
+
+// A thread atual passa a contar para sessao até encerra() ou o destrutor, que
+// descarregam o que ela contou; o que havia antes vai para a sessão anterior,
+// que volta a valer. Aninhar com a mesma sessão não faz nada.
+class EscopoInstrumentado
+{
+public:
+    explicit EscopoInstrumentado(SessaoInstrumentada* sessao);
+    ~EscopoInstrumentado() { encerra(); }
+    void encerra();
+
+private:
+    static void descarrega(SessaoInstrumentada* sessao);
+
+    SessaoInstrumentada* _sessao;
+    SessaoInstrumentada* _anterior;
+    bool                 _ativo;
+};
+
+// Mede o escopo (ou até encerra()) como uma fase da sessão da thread. As fases
+// podem se aninhar: a construção do reativo inclui o reparo.
+class FaseMedida
+{
+public:
+    explicit FaseMedida(const char* nome) : _nome(nome), _inicio(chrono::steady_clock::now()), _ativa(true) {}
+    ~FaseMedida() { encerra(); }
+    void encerra();
+
+private:
+    const char*                      _nome;
+    chrono::steady_clock::time_point _inicio;
+    bool                             _ativa;
+};
+
+SessaoInstrumentada* sessao_atual();
+
+#else
+
+#define INSTRUMENT_COUNT(contador) ((void)0)
+#define INSTRUMENT_ADD(contador, n) ((void)0)
+#define INSTRUMENT_PHASE(nome) ((void)0)
+#define INSTRUMENT_PHASE_BEGIN(fase, nome) ((void)0)
+#define INSTRUMENT_PHASE_END(fase) ((void)0)
+
+static constexpr bool INSTRUMENTACAO = false;
+
+class SessaoInstrumentada
+{
+public:
+    explicit SessaoInstrumentada(bool, size_t = 0) {}
+    void escreve_resumo(ostream&, double) const {}
+    bool escreve_trace(const string&) const { return true; }
+};
+
+class EscopoInstrumentado
+{
+public:
+    explicit EscopoInstrumentado(SessaoInstrumentada*) {}
+    void encerra() {}
+};
+
+inline SessaoInstrumentada* sessao_atual() { return nullptr; }
+
+#endif  //INSTRUMENT
+
+#endif  //INSTRUMENT_HPP
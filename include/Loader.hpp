@@ -0,0 +1,36 @@
+#ifndef LOADER_HPP
+#define LOADER_HPP
+
+#include "CSR.hpp"
+#include "MappedFile.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Lê uma instância no formato AMPL de instancias/ (param p, set V, param w,
+// set E) direto de um buffer em memória e monta a CSR não direcionada, sem
+// arestas repetidas. Retorna false se o texto não pôde ser interpretado.
+bool carrega_instancia(const char* data, size_t size, CSR& csr, size_t& num_clusters);
+
+// Formato binário versionado: o cabeçalho abaixo seguido dos arrays da CSR na
+// ordem offsets[n+1] (uint64), ids[n] (uint64), weights[n] (float, completado
+// até múltiplo de 8 bytes) e targets[m] (uint32), na ordem de bytes da máquina.
+// Como tudo fica alinhado, a CSR aponta direto para o arquivo mapeado.
+struct BinaryHeader
+{
+    char     magic[8];     // "TDGRAFOB"
+    uint32_t version;
+    uint32_t byte_order;   // BINARY_BYTE_ORDER gravado na ordem nativa
+    uint64_t num_clusters;
+    uint64_t num_vertices;
+    uint64_t num_arcs;     // arestas contadas nos dois sentidos
+};
+
+const uint32_t BINARY_VERSION = 1;
+const uint32_t BINARY_BYTE_ORDER = 0x01020304;
+
+bool eh_binario(const char* data, size_t size);
+bool carrega_binario(const shared_ptr<MappedFile>& file, CSR& csr, size_t& num_clusters);
+bool escreve_binario(const CSR& csr, size_t num_clusters, const string& path);
+
+#endif  //LOADER_HPP
@@ -0,0 +1,87 @@
+#ifndef LOCAL_SEARCH_HPP
+#define LOCAL_SEARCH_HPP
+
+#include "CSR.hpp"
+#include "Partition.hpp"
+#include "Pool.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Instante em que a busca local e o path-relinking devolvem o que têm; o padrão
+// (time_point::max()) é sem prazo
+typedef chrono::steady_clock::time_point Deadline;
+
+// Busca local sobre uma partição em que cada cluster é conexo e tem pelo menos
+// dois vértices. Vizinhanças: realocar um vértice para um cluster adjacente e
+// trocar dois vértices adjacentes de clusters diferentes.
+//
+// Cada cluster guarda seus pesos num multiset, então o gap depois de tirar ou
+// pôr um vértice sai em O(1) a partir das extremidades (O(log k) para aplicar).
+// A conectividade só é verificada para movimentos que melhoram: na realocação
+// pelos pontos de articulação do cluster (Tarjan, recalculado só quando o
+// cluster muda) e na troca por uma busca restrita aos dois clusters.
+//
+// A instância é feita para ser reaproveitada entre iterações: load() desfaz só
+// o que a carga anterior marcou e os nós dos multisets vêm de um NodeRecycler,
+// então, depois da primeira carga, nada é pedido ao heap.
+class LocalSearch
+{
+public:
+    explicit LocalSearch(const CSR& graph);
+
+    void load(const vector<vector<uint32_t>>& clusters);
+    void load(const Partition& partition);
+    // Com prazo, o relógio é consultado a cada DEADLINE_CHECK arestas percorridas,
+    // para o intervalo não depender do grau; a partição interrompida continua
+    // válida, pois cada movimento preserva a validade
+    float run(size_t max_passes = numeric_limits<size_t>::max(), Deadline deadline = Deadline::max());
+
+    static constexpr size_t DEADLINE_CHECK = 4096;
+
+    size_t num_clusters() const { return _members.size(); }
+    const vector<uint32_t>& members(uint32_t c) const { return _members[c]; }
+    uint32_t label(uint32_t v) const { return _label[v]; }
+    const vector<uint32_t>& labels() const { return _label; }
+    float gap(uint32_t c) const;
+    float total_gap() const;
+
+    float relocate_delta(uint32_t v, uint32_t to) const;
+    float swap_delta(uint32_t u, uint32_t v) const;
+    bool can_relocate(uint32_t v, uint32_t to);
+    bool can_swap(uint32_t u, uint32_t v);
+    void relocate(uint32_t v, uint32_t to);
+    void swap(uint32_t u, uint32_t v);
+
+private:
+    float gap_without(uint32_t c, float removed) const;
+    float gap_with(uint32_t c, float added) const;
+    float gap_exchanging(uint32_t c, float removed, float added) const;
+    bool is_articulation(uint32_t v);
+    void compute_articulations(uint32_t c);
+    bool connected_after_exchange(uint32_t c, uint32_t removed, uint32_t added);
+    void clear(size_t num_clusters);
+    void insert(uint32_t v, uint32_t c);
+    void erase(uint32_t v);
+
+    typedef multiset<float, less<float>, RecyclingAllocator<float>> WeightSet;
+
+    const CSR&               _graph;
+    vector<uint32_t>         _label;
+    vector<uint32_t>         _position; // posição de v em _members[_label[v]]
+    vector<vector<uint32_t>> _members;
+    unique_ptr<NodeRecycler> _recycler; // endereço estável mesmo se a LocalSearch for movida
+    vector<WeightSet>        _weights;
+    vector<char>             _articulation;
+    vector<char>             _dirty;    // pontos de articulação do cluster desatualizados
+
+    // Buffers reaproveitados pelas buscas em profundidade
+    vector<uint32_t>         _stamp;
+    uint32_t                 _epoch;
+    vector<uint32_t>         _disc;
+    vector<uint32_t>         _low;
+    vector<uint32_t>         _stack;
+    vector<size_t>           _edge_pos;
+};
+
+#endif  //LOCAL_SEARCH_HPP
@@ -0,0 +1,36 @@
+#ifndef LOWER_BOUND_HPP
+#define LOWER_BOUND_HPP
+
+#include "CSR.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Limite inferior para a soma dos gaps de qualquer partição válida (p clusters
+// conexos com pelo menos dois vértices).
+//
+// Para um conjunto de clusters, os intervalos [mín, máx] de cada um cobrem
+// todos os pesos; a soma dos gaps é pelo menos o tamanho dessa união, que é a
+// amplitude dos pesos menos no máximo p - 1 buracos entre pesos consecutivos
+// na ordem crescente. Cada trecho entre dois buracos contém clusters inteiros,
+// logo tem pelo menos dois vértices. Escolher os buracos é uma DP O(n p).
+//
+// Refinamentos pela estrutura do grafo:
+//  - cada cluster fica dentro de uma componente conexa, então o limite é a
+//    melhor divisão dos p clusters entre as componentes (mochila sobre p);
+//  - uma folha está sempre no cluster do seu único vizinho (a aresta é uma
+//    ponte com um lado de um vértice só), então não pode haver buraco entre
+//    os pesos dos dois.
+struct LowerBound
+{
+    float  valor = 0;       // limite para a soma dos gaps
+    bool   viavel = true;   // false se nenhuma partição válida existe
+    size_t componentes = 0;
+};
+
+LowerBound calcula_limite_inferior(const CSR& graph, size_t p);
+
+// Quanto falta, em porcentagem do gap encontrado, para o limite inferior
+double gap_restante_pct(float gap, float limite);
+
+#endif  //LOWER_BOUND_HPP
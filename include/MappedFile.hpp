@@ -0,0 +1,29 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include "defines.hpp"
+
+using namespace std;
+
+// Arquivo mapeado em memória somente para leitura (mmap). O conteúdo fica
+// disponível em data()/size() enquanto o objeto existir.
+class MappedFile
+{
+public:
+    explicit MappedFile(const string& path);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool is_open() const { return _open; }
+    const char* data() const { return static_cast<const char*>(_data); }
+    size_t size() const { return _size; }
+
+private:
+    int    _fd;
+    bool   _open;
+    void*  _data;
+    size_t _size;
+};
+
+#endif  //MAPPED_FILE_HPP
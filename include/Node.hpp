@@ -9,6 +9,7 @@ struct Node
     size_t _number_of_edges;
     size_t _id;
     float  _weight;
+    size_t _index; // posição do vértice na CSR
     Edge  *_first_edge;
     Node  *_next_node;
     Node  *_previous_node;
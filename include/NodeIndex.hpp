@@ -0,0 +1,68 @@
+#ifndef GRAFO_BASICO_NODE_INDEX_H
+#define GRAFO_BASICO_NODE_INDEX_H
+
+#include "Instrument.hpp"
+#include "Node.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Índice persistente id -> valor (None quando o id não existe). Enquanto os ids
+// forem compactos (o caso de "set V := 1..n") usa um vetor indexado pelo
+// próprio id; se aparecer um id muito esparso, migra uma única vez para uma
+// tabela hash.
+template <typename T, T None>
+struct IdIndex
+{
+    vector<T>                dense;
+    unordered_map<size_t, T> sparse;
+    size_t                   count = 0;
+    bool                     use_dense = true;
+
+    T find(size_t id) const {
+        INSTRUMENT_COUNT(BUSCAS_ID);
+        if (use_dense) {
+            return id < dense.size() ? dense[id] : None;
+        }
+        auto it = sparse.find(id);
+        return it == sparse.end() ? None : it->second;
+    }
+
+    void insert(size_t id, T value) {
+        ++count;
+        if (use_dense && id >= dense.size() && id >= 2 * count + 64) {
+            // O vetor ficaria mais que metade vazio: passa a usar a tabela hash
+            sparse.reserve(count);
+            for (size_t i = 0; i < dense.size(); ++i) {
+                if (dense[i] != None) {
+                    sparse.emplace(i, dense[i]);
+                }
+            }
+            dense.clear();
+            dense.shrink_to_fit();
+            use_dense = false;
+        }
+        if (use_dense) {
+            if (id >= dense.size()) {
+                dense.resize(max(id + 1, dense.size() * 2), None);
+            }
+            dense[id] = value;
+        } else {
+            sparse[id] = value;
+        }
+    }
+
+    void erase(size_t id) {
+        if (find(id) == None) return;
+        --count;
+        if (use_dense) {
+            dense[id] = None;
+        } else {
+            sparse.erase(id);
+        }
+    }
+};
+
+typedef IdIndex<Node*, nullptr> NodeIndex;
+
+#endif  //GRAFO_BASICO_NODE_INDEX_H
@@ -0,0 +1,51 @@
+#ifndef PARTITION_HPP
+#define PARTITION_HPP
+
+#include "CSR.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Partição dos vértices da CSR em clusters, mantida de forma incremental:
+// cada vértice guarda o rótulo do seu cluster e cada cluster guarda sua
+// fronteira (vértices ainda sem cluster adjacentes a ele). Assim "v é
+// adjacente ao cluster c?" custa O(grau(v)) em vez de uma DFS por candidato.
+// reset() custa O(vértices atribuídos), então a mesma partição serve a todas
+// as iterações de um worker.
+class Partition
+{
+public:
+    static constexpr uint32_t NONE = numeric_limits<uint32_t>::max();
+
+    Partition(const CSR& graph, size_t num_clusters);
+
+    void reset(size_t num_clusters);
+    void assign(uint32_t v, uint32_t c);
+    bool is_adjacent(uint32_t v, uint32_t c) const;
+    uint32_t first_adjacent_cluster(uint32_t v) const;
+    bool has_free_neighbor(uint32_t v) const;
+    uint32_t next_frontier(uint32_t c);
+    size_t repair();
+
+    uint32_t label(uint32_t v) const { return _label[v]; }
+    bool assigned(uint32_t v) const { return _label[v] != NONE; }
+    size_t num_clusters() const { return _members.size(); }
+    size_t num_assigned() const { return _num_assigned; }
+    const vector<uint32_t>& members(uint32_t c) const { return _members[c]; }
+    float min_weight(uint32_t c) const { return _min_weight[c]; }
+    float max_weight(uint32_t c) const { return _max_weight[c]; }
+
+private:
+    const CSR&               _graph;
+    vector<uint32_t>         _label;
+    vector<vector<uint32_t>> _members;
+    vector<vector<uint32_t>> _frontier;      // pode conter vértices já atribuídos (remoção preguiçosa)
+    vector<size_t>           _frontier_head; // primeira posição ainda não consumida da fronteira
+    vector<float>            _min_weight;
+    vector<float>            _max_weight;
+    size_t                   _num_assigned;
+    vector<uint32_t>         _queue;         // buffers de repair(), sempre devolvidos zerados
+    vector<char>             _queued;
+};
+
+#endif  //PARTITION_HPP
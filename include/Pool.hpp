@@ -0,0 +1,165 @@
+#ifndef GRAFO_BASICO_POOL_H
+#define GRAFO_BASICO_POOL_H
+
+#include "defines.hpp"
+
+using namespace std;
+
+// Pool de objetos em blocos (slabs) para os nós e arestas da visão por
+// ponteiros. allocate() pega um objeto liberado ou avança no bloco atual;
+// release() devolve o objeto para uma lista livre encadeada dentro dele mesmo.
+// Os blocos só são devolvidos ao sistema quando o pool é destruído, então
+// desmontar o grafo custa um delete por bloco, não por nó ou aresta.
+//
+// Os objetos não são construídos nem destruídos: T precisa ser trivial.
+template <typename T>
+class Pool
+{
+public:
+    Pool() : _free(nullptr), _cursor(nullptr), _end(nullptr), _live(0), _allocations(0), _next_block(FIRST_BLOCK) {}
+    Pool(const Pool&) = delete;
+    Pool& operator=(const Pool&) = delete;
+
+    T* allocate() {
+        ++_allocations;
+        ++_live;
+        if (_free) {
+            Slot* slot = _free;
+            _free = slot->next;
+            return &slot->value;
+        }
+        if (_cursor == _end) {
+            grow(_next_block);
+        }
+        return &(_cursor++)->value;
+    }
+
+    void release(T* object) {
+        Slot* slot = reinterpret_cast<Slot*>(object);
+        slot->next = _free;
+        _free = slot;
+        --_live;
+    }
+
+    // Garante espaço para count objetos seguidos num único bloco
+    void reserve(size_t count) {
+        if (size_t(_end - _cursor) < count) {
+            grow(count);
+        }
+    }
+
+    size_t live() const { return _live; }               // objetos em uso
+    size_t allocations() const { return _allocations; } // chamadas a allocate() desde a criação
+    size_t blocks() const { return _blocks.size(); }    // alocações feitas no heap
+
+private:
+    static_assert(is_trivially_copyable<T>::value && is_trivially_destructible<T>::value, "Pool exige um tipo trivial");
+    static const size_t FIRST_BLOCK = 64;
+    static const size_t MAX_BLOCK = 1 << 16;
+
+    union Slot {
+        T     value;
+        Slot* next;
+    };
+
+    // O resto do bloco atual (se houver) é abandonado; só acontece em reserve()
+    void grow(size_t count) {
+        _blocks.emplace_back(new Slot[count]);
+        _cursor = _blocks.back().get();
+        _end = _cursor + count;
+        _next_block = min(max(_next_block, count) * 2, MAX_BLOCK);
+    }
+
+    vector<unique_ptr<Slot[]>> _blocks;
+    Slot*                      _free;
+    Slot*                      _cursor;
+    Slot*                      _end;
+    size_t                     _live;
+    size_t                     _allocations;
+    size_t                     _next_block;
+};
+
+// Reaproveita os nós de containers como set/multiset/map: um nó liberado volta
+// para a lista livre do seu tamanho em vez de ir para o heap. Feito para uso
+// por uma única thread (uma instância por worker).
+class NodeRecycler
+{
+public:
+    NodeRecycler() : _cursor(nullptr), _end(nullptr) {}
+    NodeRecycler(const NodeRecycler&) = delete;
+    NodeRecycler& operator=(const NodeRecycler&) = delete;
+
+    void* allocate(size_t bytes) {
+        const size_t size_class = (bytes + GRAIN - 1) / GRAIN;
+        if (size_class >= MAX_CLASS) {
+            return ::operator new(bytes);
+        }
+        if (size_class < _free.size() && _free[size_class]) {
+            FreeSlot* slot = _free[size_class];
+            _free[size_class] = slot->next;
+            return slot;
+        }
+        const size_t rounded = size_class * GRAIN;
+        if (size_t(_end - _cursor) < rounded) {
+            _blocks.emplace_back(new char[BLOCK_BYTES]);
+            _cursor = _blocks.back().get();
+            _end = _cursor + BLOCK_BYTES;
+        }
+        void* result = _cursor;
+        _cursor += rounded;
+        return result;
+    }
+
+    void release(void* pointer, size_t bytes) {
+        const size_t size_class = (bytes + GRAIN - 1) / GRAIN;
+        if (size_class >= MAX_CLASS) {
+            ::operator delete(pointer);
+            return;
+        }
+        if (size_class >= _free.size()) {
+            _free.resize(size_class + 1, nullptr);
+        }
+        FreeSlot* slot = static_cast<FreeSlot*>(pointer);
+        slot->next = _free[size_class];
+        _free[size_class] = slot;
+    }
+
+    size_t blocks() const { return _blocks.size(); }
+
+private:
+    static const size_t GRAIN = alignof(max_align_t);
+    static const size_t MAX_CLASS = 16;
+    static const size_t BLOCK_BYTES = 64 * 1024;
+
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    vector<unique_ptr<char[]>> _blocks;
+    vector<FreeSlot*>          _free;
+    char*                      _cursor;
+    char*                      _end;
+};
+
+// Alocador STL sobre um NodeRecycler; cópias e rebinds compartilham o mesmo recycler
+template <typename T>
+struct RecyclingAllocator
+{
+    typedef T value_type;
+
+    NodeRecycler* recycler;
+
+    explicit RecyclingAllocator(NodeRecycler* recycler) : recycler(recycler) {}
+    template <typename U>
+    RecyclingAllocator(const RecyclingAllocator<U>& other) : recycler(other.recycler) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(recycler->allocate(n * sizeof(T))); }
+    void deallocate(T* pointer, size_t n) { recycler->release(pointer, n * sizeof(T)); }
+
+    template <typename U>
+    bool operator==(const RecyclingAllocator<U>& other) const { return recycler == other.recycler; }
+    template <typename U>
+    bool operator!=(const RecyclingAllocator<U>& other) const { return recycler != other.recycler; }
+};
+
+#endif  //GRAFO_BASICO_POOL_H
@@ -0,0 +1,98 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+
+#include "defines.hpp"
+
+using namespace std;
+
+// Gerador das heurísticas: xoshiro256** (Blackman e Vigna), semeado por
+// splitmix64 a partir de uma semente de 64 bits. Cada thread usa split(w),
+// que avança o estado w + 1 saltos de 2^128 passos, então as sequências das
+// threads nunca se sobrepõem e dependem só de (semente, w).
+//
+// Satisfaz UniformRandomBitGenerator, mas as heurísticas usam uniform() e
+// real(), que não dependem dos bits baixos nem de implementações da STL.
+class Random
+{
+public:
+    typedef uint64_t result_type;
+
+    explicit Random(uint64_t seed = 1) {
+        uint64_t x = seed;
+        for (uint64_t& word : _state) {
+            word = splitmix64(x);
+        }
+    }
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return numeric_limits<uint64_t>::max(); }
+
+    uint64_t operator()() {
+        const uint64_t result = rotl(_state[1] * 5, 7) * 9;
+        const uint64_t t = _state[1] << 17;
+        _state[2] ^= _state[0];
+        _state[3] ^= _state[1];
+        _state[1] ^= _state[2];
+        _state[0] ^= _state[3];
+        _state[2] ^= t;
+        _state[3] = rotl(_state[3], 45);
+        return result;
+    }
+
+    // Inteiro em [0, bound) pela multiplicação de Lemire, usando os bits altos
+    uint64_t uniform(uint64_t bound) {
+        return (uint64_t)(((unsigned __int128)(*this)() * bound) >> 64);
+    }
+
+    // Real em [0, 1) com 53 bits
+    double real() {
+        return ((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    // Gerador independente para a thread (ou fluxo) worker
+    Random split(size_t worker) const {
+        Random other = *this;
+        for (size_t i = 0; i <= worker; ++i) {
+            other.jump();
+        }
+        return other;
+    }
+
+    // Estado completo, para checkpoints: restore(state()) continua a mesma sequência
+    const uint64_t* state() const { return _state; }
+    void restore(const uint64_t state[4]) {
+        for (int i = 0; i < 4; ++i) _state[i] = state[i];
+    }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    // Equivale a 2^128 chamadas de operator()
+    void jump() {
+        static const uint64_t JUMP[] = { 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                         0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+        uint64_t s[4] = { 0, 0, 0, 0 };
+        for (uint64_t word : JUMP) {
+            for (int b = 0; b < 64; ++b) {
+                if (word & (1ULL << b)) {
+                    for (int i = 0; i < 4; ++i) s[i] ^= _state[i];
+                }
+                (*this)();
+            }
+        }
+        for (int i = 0; i < 4; ++i) _state[i] = s[i];
+    }
+
+    uint64_t _state[4];
+};
+
+#endif  //RANDOM_HPP
@@ -0,0 +1,70 @@
+#ifndef RANK_FRONTIER_HPP
+#define RANK_FRONTIER_HPP
+
+#include "CSR.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Vértices em ordem crescente de peso (empates pelo índice) e a posição de
+// cada um nessa ordem. Calculada uma vez por grafo (Graph::ordem_por_peso).
+struct WeightOrder
+{
+    vector<uint32_t> order;  // order[r] = vértice de posto r
+    vector<uint32_t> rank;   // rank[v] = posto de v
+    vector<float>    sorted; // sorted[r] = peso de order[r]
+
+    WeightOrder() = default;
+    explicit WeightOrder(const CSR& graph);
+
+    size_t size() const { return order.size(); }
+    // Primeiro posto com peso >= weight / > weight
+    uint32_t first_at_least(float weight) const;
+    uint32_t first_above(float weight) const;
+};
+
+// Fronteira de um cluster em construção, indexada pelo posto do peso: uma
+// árvore de Fenwick sobre os postos marca quais vértices livres estão nela.
+// Cada vértice entra no máximo uma vez, e achar o candidato mais próximo da
+// faixa [menor, maior] do cluster, contar os candidatos numa faixa de pesos ou
+// tomar o k-ésimo deles custa O(log n). clear() custa O(tamanho log n), então a
+// mesma fronteira serve a todos os clusters e iterações de um worker.
+class RankFrontier
+{
+public:
+    static constexpr uint32_t NONE = numeric_limits<uint32_t>::max();
+
+    explicit RankFrontier(const WeightOrder& order);
+
+    void insert(uint32_t v);
+    void erase(uint32_t v);
+    void clear();
+    bool contains(uint32_t v) const { return _present[_order.rank[v]]; }
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+    // Vértice de menor aumento de gap para um cluster com pesos em [low, high]
+    // (dentro da faixa vale 0); NONE se vazia
+    uint32_t nearest(float low, float high) const;
+    // Candidatos com peso em [low, high]: são os de índice [first, last) na
+    // ordem de peso da fronteira; at(k) é o candidato de índice k
+    pair<size_t, size_t> range(float low, float high) const;
+    uint32_t at(size_t k) const { return _order.order[select(k)]; }
+    // Candidatos de menor e maior peso
+    uint32_t lightest() const { return empty() ? NONE : at(0); }
+    uint32_t heaviest() const { return empty() ? NONE : at(_size - 1); }
+
+private:
+    void add(uint32_t rank, int delta);
+    size_t prefix(uint32_t rank) const; // candidatos com posto < rank
+    uint32_t select(size_t k) const;    // posto do k-ésimo candidato
+
+    const WeightOrder& _order;
+    vector<int32_t>    _tree;
+    vector<char>       _present;
+    vector<uint32_t>   _members; // postos inseridos desde o último clear (alguns já removidos)
+    size_t             _size;
+    uint32_t           _top;     // maior potência de 2 <= n, para select()
+};
+
+#endif  //RANK_FRONTIER_HPP
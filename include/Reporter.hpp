@@ -0,0 +1,65 @@
+#ifndef REPORTER_HPP
+#define REPORTER_HPP
+
+#include "CSR.hpp"
+#include "Grasp.hpp"
+#include "LowerBound.hpp"
+#include "Solution.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+class LocalSearch;
+
+// Escreve blocos de texto num ostream a partir de uma thread própria, para que
+// quem produz o texto não espere pela E/S. Os blocos saem na ordem de chegada.
+class AsyncWriter
+{
+public:
+    explicit AsyncWriter(ostream& out);
+    ~AsyncWriter();
+
+    void write(string&& text);
+    void flush(); // espera até tudo o que foi enviado estar escrito
+
+private:
+    void loop();
+
+    ostream&           _out;
+    mutex              _mutex;
+    condition_variable _ready;
+    condition_variable _drained;
+    vector<string>     _queue;
+    bool               _writing;
+    bool               _stop;
+    thread             _thread;
+};
+
+enum class Verbosity {
+    SILENT,    // nada
+    SUMMARY,   // só a solução final
+    PROGRESS,  // também uma linha a cada melhora do incumbente, pelo escritor assíncrono
+    ITERATIONS // também cada iteração do reativo
+};
+
+// Impressão dos resultados, separada das heurísticas
+class Reporter
+{
+public:
+    Reporter(const CSR& graph, Verbosity verbosity, ostream& out = cout);
+
+    // Observadores para GraspConfig::on_iteration (vazio abaixo de ITERATIONS)
+    // e GraspConfig::on_incumbent (vazio abaixo de PROGRESS)
+    IterationObserver observer();
+    IncumbentObserver incumbent_observer();
+    void report(const Solution& solution);
+    void flush();
+
+private:
+    const CSR&              _graph;
+    Verbosity               _verbosity;
+    ostream&                _out;
+    unique_ptr<AsyncWriter> _writer;
+};
+
+#endif  //REPORTER_HPP
@@ -0,0 +1,51 @@
+#ifndef SOLUTION_HPP
+#define SOLUTION_HPP
+
+#include "defines.hpp"
+
+using namespace std;
+
+// Declaração da estrutura Subgraph
+struct Subgraph {
+    vector<size_t> vertices; // Vértices no subgrafo
+    float max_weight;             // Maior peso no subgrafo
+    float min_weight;             // Menor peso no subgrafo
+    float total_weight;
+
+    Subgraph() : max_weight(0), min_weight(0) {}
+};
+
+// Uma iteração válida do GRASP reativo
+struct IterationRecord {
+    size_t iteracao; // a partir de 0
+    float  alpha;
+    float  gap;      // gap total depois da busca local
+};
+
+// Melhora do incumbente no reativo, com o instante desde o início da busca
+struct IncumbentRecord {
+    size_t iteracao;
+    float  gap;
+    double segundos;
+};
+
+// Resultado de uma heurística: a partição (ids originais), o gap de cada
+// subgrafo e, no reativo, o histórico das iterações e das melhoras. As heurísticas
+// não escrevem nada; a impressão fica com o Reporter.
+struct Solution {
+    vector<Subgraph>        subgraphs;
+    vector<float>           gaps;
+    float                   total_gap = -1; // -1 quando a heurística falhou
+    string                  erro;           // motivo da falha
+    uint64_t                semente = 0;    // repete a execução (no reativo, com o mesmo número de threads)
+    float                   limite_inferior = -1; // ver LowerBound.hpp; negativo se a instância é inviável
+    bool                    otimo = false;  // o modo exato provou que não há partição melhor
+    vector<IterationRecord> trace;
+    vector<IncumbentRecord> melhorias;      // cada melhora do incumbente, em ordem de tempo
+    double                  tempo_anterior = 0; // segundos já rodados antes de retomar de um checkpoint;
+                                                // os instantes de melhorias já os incluem
+
+    bool ok() const { return erro.empty(); }
+};
+
+#endif  //SOLUTION_HPP
@@ -0,0 +1,21 @@
+#ifndef SOLUTION_FILE_HPP
+#define SOLUTION_FILE_HPP
+
+#include "CSR.hpp"
+#include "Solution.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Arquivo de solução em texto: um cabeçalho com o número de vértices, de
+// clusters e o gap total, seguido do cluster de cada vértice (1..p, 0 = fora de
+// todos), um por linha, na ordem dos vértices em set V (a dos índices densos
+// da CSR, que o formato binário preserva). Só vale para a mesma instância.
+bool escreve_solucao(const CSR& graph, const Solution& solution, const string& path);
+
+// Monta a Solution do arquivo, com os gaps dos subgrafos recalculados a partir
+// dos pesos e o gap total do cabeçalho (valida_solucao confere um contra o
+// outro); em caso de problema, erro vem preenchido
+Solution le_solucao(const CSR& graph, const string& path);
+
+#endif  //SOLUTION_FILE_HPP
@@ -0,0 +1,75 @@
+#ifndef TABU_SEARCH_HPP
+#define TABU_SEARCH_HPP
+
+#include "CSR.hpp"
+#include "Grasp.hpp"
+#include "LocalSearch.hpp"
+#include "Random.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Parâmetros da busca tabu (Graph::busca_tabu)
+struct TabuConfig
+{
+    size_t   max_iter = 10000;   // movimentos; 0 = até o limite de tempo ou o alvo
+    double   time_limit = 0;     // segundos; 0 = sem limite
+    float    target_gap = -1;    // para assim que o gap ficar <= alvo; negativo = sem alvo
+    bool     stop_at_bound = true; // para se o incumbente atingir o limite inferior
+    size_t   tenure = 10;        // duração mínima do tabu, em iterações
+    size_t   tenure_range = 10;  // a duração é sorteada em [tenure, tenure + tenure_range)
+    size_t   stagnation = 0;     // iterações sem melhora antes de uma perturbação; 0 = max(100, n)
+    size_t   kick = 0;           // realocações aleatórias de cada perturbação; 0 = max(3, n / 50)
+    uint64_t seed = 1;
+    IncumbentObserver on_incumbent; // opcional, a cada melhora do incumbente
+};
+
+struct TabuStats
+{
+    size_t iterations = 0;  // movimentos feitos
+    size_t aspirations = 0; // movimentos tabu aceitos por melhorarem o incumbente
+    size_t kicks = 0;       // perturbações
+};
+
+// Busca tabu sobre realocações de um vértice para um cluster adjacente, com a
+// estrutura incremental da LocalSearch: o gap depois do movimento sai dos
+// multisets de pesos e a conectividade dos pontos de articulação, sem montar
+// subgrafos. A cada iteração aplica o melhor movimento admissível, mesmo que
+// piore o gap (empates sorteados). Tirar v do cluster c torna tabu devolvê-lo a
+// c por uma duração sorteada; um movimento tabu só é admissível se levar a um
+// gap menor que o do incumbente (aspiração). Depois de stagnation iterações sem
+// melhora, recomeça do incumbente com kick realocações aleatórias (busca local
+// iterada).
+class TabuSearch
+{
+public:
+    TabuSearch(const CSR& graph, const TabuConfig& config);
+
+    // Parte de clusters conexos com pelo menos dois vértices cada. Para ao fim das
+    // iterações, do tempo ou quando o incumbente chega a stop_gap (negativo = nunca).
+    // Cada melhora vai para improvements, com o instante desde start.
+    void run(const vector<vector<uint32_t>>& clusters, float stop_gap, chrono::steady_clock::time_point start,
+             vector<IncumbentRecord>& improvements, TabuStats& stats);
+
+    const vector<vector<uint32_t>>& best() const { return _best; }
+    float best_gap() const { return _best_gap; }
+
+private:
+    bool melhor_movimento(float current_gap, uint32_t& vertex, uint32_t& to, float& delta, bool& aspiration);
+    bool tabu(uint32_t v, uint32_t c) const;
+    void torna_tabu(uint32_t v, uint32_t c);
+    void perturba();
+
+    const CSR&               _graph;
+    const TabuConfig&        _config;
+    LocalSearch              _search;
+    Random                   _rng;
+    size_t                   _iteration;
+    unordered_map<uint64_t, size_t> _tabu_until; // v * p + c -> última iteração em que devolver v a c é tabu
+    vector<size_t>           _seen;              // _seen[c] == _epoch: c já avaliado para o vértice atual
+    size_t                   _epoch;
+    vector<vector<uint32_t>> _best;
+    float                    _best_gap;
+};
+
+#endif  //TABU_SEARCH_HPP
@@ -0,0 +1,36 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include "Instrument.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Conjunto fixo de threads no estilo SPMD: run(job) executa job(w) uma vez em
+// cada worker w = 0..size()-1 e só retorna quando todos terminarem. A thread
+// chamadora faz o papel do worker 0, então ThreadPool(1) não cria threads.
+// Os workers contam para a sessão de instrumentação de quem chamou run().
+class ThreadPool
+{
+public:
+    explicit ThreadPool(size_t threads);
+    ~ThreadPool();
+
+    size_t size() const { return _threads.size() + 1; }
+    void run(const function<void(size_t)>& job);
+
+private:
+    void loop(size_t worker);
+
+    vector<thread>                 _threads;
+    mutex                          _mutex;
+    condition_variable             _start;
+    condition_variable             _done;
+    const function<void(size_t)>*  _job;
+    SessaoInstrumentada*           _session;
+    size_t                         _generation;
+    size_t                         _pending;
+    bool                           _stop;
+};
+
+#endif  //THREAD_POOL_HPP
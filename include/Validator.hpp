@@ -0,0 +1,22 @@
+#ifndef VALIDATOR_HPP
+#define VALIDATOR_HPP
+
+#include "CSR.hpp"
+#include "Solution.hpp"
+#include "defines.hpp"
+
+using namespace std;
+
+// Cluster de cada vértice (índice denso da CSR) segundo os subgrafos da solução;
+// Partition::NONE para os que não aparecem. Devolve a descrição do problema se
+// algum id não existe no grafo ou aparece duas vezes, ou "" se não há problema.
+string rotulos_solucao(const CSR& graph, const Solution& solution, vector<uint32_t>& label);
+
+// Confere em O(n + m) que a solução é uma partição de todos os vértices em p
+// subgrafos conexos com pelo menos dois vértices cada e que os gaps informados
+// (de cada subgrafo e o total) batem com os pesos. Devolve a descrição do
+// primeiro problema encontrado ou "" se a solução é válida; label, se dado,
+// recebe o cluster de cada vértice.
+string valida_solucao(const CSR& graph, const Solution& solution, size_t p, vector<uint32_t>* label = nullptr);
+
+#endif  //VALIDATOR_HPP
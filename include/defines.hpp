@@ -13,8 +13,18 @@
 #include <random> // Para gerar números aleatórios
 #include <queue>
 #include <unordered_set>
+#include <unordered_map>
 #include <stack>
 #include <set>
 #include <cfloat>
+#include <cstring>
+#include <cstdint> /* inteiros de largura fixa usados na representação compacta */
+#include <limits>
+#include <functional>
+#include <thread> /* execução paralela das iterações */
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
 
 #endif  //DEFINES_HPP   
\ No newline at end of file
@@ -1,4 +1,9 @@
+#include "include/Batch.hpp"
+#include "include/Generator.hpp"
 #include "include/Graph.hpp"
+#include "include/Reporter.hpp"
+#include "include/SolutionFile.hpp"
+#include "include/Validator.hpp"
 #include "include/defines.hpp"
 
 using namespace std;
@@ -9,13 +14,55 @@ void showMenu() {
     cout << "2) Guloso randomizado adaptativo\n";
     cout << "3) Guloso randomizado adaptativo reativo\n";
     cout << "4) Imprimir grafo\n"; // Nova opção para imprimir o grafo
+    cout << "5) Exato (branch-and-bound)\n";
+    cout << "6) Busca tabu\n";
     cout << "0) Sair\n";
     cout << "Escolha uma opcao: ";
 }
 
 int main(int argc, char* argv[]) {
+    // Conversão de uma instância em texto para o formato binário
+    if (argc == 4 && string(argv[1]) == "--converte") {
+        Graph graph{string(argv[2])};
+        if (!graph.salva_binario(argv[3])) {
+            return 1;
+        }
+        cout << "Instância convertida: " << argv[3] << "\n";
+        return 0;
+    }
+
+    // Confere e pontua um arquivo de solução
+    if (argc == 4 && string(argv[1]) == "--pontua") {
+        Graph graph{string(argv[2])};
+        Solution solution = le_solucao(graph.csr(), argv[3]);
+        const string problem = solution.ok() ? valida_solucao(graph.csr(), solution, graph._num_clusters) : solution.erro;
+        if (solution.ok()) {
+            cout << "Gap total: " << solution.total_gap << "\n";
+        }
+        if (!problem.empty()) {
+            cout << "Solução inválida: " << problem << "\n";
+            return 1;
+        }
+        cout << "Solução válida\n";
+        return 0;
+    }
+
+    // Geração de instâncias sintéticas
+    if (argc >= 2 && string(argv[1]) == "--gera") {
+        return executa_gerador(argc, argv);
+    }
+
+    // Qualquer outra combinação de argumentos é o modo em lote (não interativo)
+    if (argc > 2 || (argc == 2 && string(argv[1]).compare(0, 2, "--") == 0)) {
+        return executa_lote(argc, argv);
+    }
+
     if (argc != 2) {
         cerr << "Uso incorreto! Uso correto: " << argv[0] << " <input_file>\n";
+        cerr << "                            " << argv[0] << " --converte <instancia.txt> <instancia.bin>\n";
+        cerr << "                            " << argv[0] << " --pontua <instância> <solução>\n";
+        cerr << "                            " << argv[0] << " --gera [opções] <arquivo|diretório>\n";
+        cerr << "                            " << argv[0] << " [opções] <instância|diretório>...\n";
         return 1;
     }
 
@@ -27,10 +74,16 @@ int main(int argc, char* argv[]) {
         return 1;
     }
 
-    // Passa o arquivo para o construtor de Graph
-    Graph graph(input_file);
     input_file.close();
 
+    // O construtor mapeia o arquivo em memória e lê a instância direto dele
+    Graph graph(input_file_name);
+
+    // Cada execução do menu usa uma semente nova, impressa junto com o resultado;
+    // para repetir, use o modo em lote com --semente (e o mesmo --threads no reativo)
+    random_device entropy;
+    auto nova_semente = [&entropy]() { return ((uint64_t)entropy() << 32) | entropy(); };
+
     int option;
     do {
         showMenu();
@@ -40,9 +93,10 @@ int main(int argc, char* argv[]) {
             case 1: {
                 size_t p = graph._num_clusters;
                 auto start = chrono::high_resolution_clock::now();
-                float total_gap = graph.guloso(p);
+                Solution solution = graph.guloso(p, true, nova_semente());
                 auto end = chrono::high_resolution_clock::now();
                 chrono::duration<double> elapsed = end - start;
+                Reporter(graph.csr(), Verbosity::SUMMARY).report(solution);
                 cout << "Tempo de execução (Guloso): " << elapsed.count() << " segundos\n";
                 break;
             }
@@ -50,26 +104,51 @@ int main(int argc, char* argv[]) {
                 size_t p = graph._num_clusters;
                 float alpha;
                 cout << "Quanto menor o alpha, mais guloso o algoritmo se torna; quanto maior, mais aleatoriedade." << endl;
-                //cout << "Digite o valor de alpha (0 <= alpha <= 1): ";
-                //cout << "Vamos considerar alpha = 0.5 " << endl;
-                //cin >> alpha;
+                cout << "Digite o valor de alpha (0 <= alpha <= 1): ";
+                if (!(cin >> alpha) || alpha < 0 || alpha > 1) {
+                    cout << "Alpha inválido!\n";
+                    cin.clear();
+                    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+                    break;
+                }
                 auto start = chrono::high_resolution_clock::now();
-                float total_gap = graph.guloso_randomizado_adaptativo(p, 0.5);
+                Solution solution = graph.guloso_randomizado_adaptativo(p, alpha, true, nova_semente());
                 auto end = chrono::high_resolution_clock::now();
                 chrono::duration<double> elapsed = end - start;
+                Reporter(graph.csr(), Verbosity::SUMMARY).report(solution);
                 cout << "Tempo de execução (Guloso Randomizado Adaptativo): " << elapsed.count() << " segundos\n";
                 break;
             }
             case 3: {
                 size_t p = graph._num_clusters;
                 size_t max_iter;
-                cout << "Digite o número de iterações para o algoritmo reativo: ";
+                cout << "Digite o número de iterações para o algoritmo reativo (0 = até um limite de tempo): ";
                 cin >> max_iter;
+                GraspConfig config;
+                if (max_iter == 0) {
+                    cout << "Limite de tempo em segundos: ";
+                    cin >> config.time_limit;
+                }
+                int level;
+                cout << "Saída (0 = silenciosa, 1 = só a melhor solução, 2 = cada melhora, 3 = cada iteração): ";
+                cin >> level;
+                Reporter reporter(graph.csr(), (Verbosity)max(0, min(level, (int)Verbosity::ITERATIONS)));
+                config.threads = max(1u, thread::hardware_concurrency());
+                config.seed = nova_semente();
+                config.on_iteration = reporter.observer();
+                config.on_incumbent = reporter.incumbent_observer();
                 auto start = chrono::high_resolution_clock::now();
-                float total_gap = graph.guloso_randomizado_adaptativo_reativo(p, max_iter);
+                AlphaStats stats;
+                Solution solution = graph.guloso_randomizado_adaptativo_reativo(p, max_iter, config, &stats);
                 auto end = chrono::high_resolution_clock::now();
                 chrono::duration<double> elapsed = end - start;
-                cout << "Gap total (Guloso Randomizado Adaptativo Reativo): " << total_gap << endl;
+                reporter.report(solution);
+                for (size_t a = 0; a < stats.alphas.size(); ++a) {
+                    cout << "alpha " << stats.alphas[a] << ": " << stats.counts[a] << " iterações, gap médio "
+                         << stats.average_gap[a] << ", probabilidade " << stats.probabilities[a] << endl;
+                }
+                cout << "Gap total (Guloso Randomizado Adaptativo Reativo): " << solution.total_gap << endl;
+                cout << "Threads: " << config.threads << endl;
                 cout << "Tempo de execução (Guloso Randomizado Adaptativo Reativo): " << elapsed.count() << " segundos\n";
                 break;
             }
@@ -78,6 +157,39 @@ int main(int argc, char* argv[]) {
                 graph.print_graph();
                 break;
             }
+            case 5: {
+                size_t p = graph._num_clusters;
+                ExactConfig config;
+                cout << "Limite de tempo em segundos (0 = até provar o ótimo): ";
+                cin >> config.time_limit;
+                config.threads = max(1u, thread::hardware_concurrency());
+                config.seed = nova_semente();
+                ExactStats stats;
+                Solution solution = graph.exato(p, config, &stats);
+                Reporter(graph.csr(), Verbosity::SUMMARY).report(solution);
+                cout << "Nós: " << stats.nos << " (" << stats.roubos << " subárvores roubadas), threads: " << config.threads << endl;
+                cout << "Tempo de execução (Exato): " << stats.tempo << " segundos na árvore\n";
+                break;
+            }
+            case 6: {
+                size_t p = graph._num_clusters;
+                TabuConfig config;
+                cout << "Digite o número de movimentos da busca tabu (0 = até um limite de tempo): ";
+                cin >> config.max_iter;
+                if (config.max_iter == 0) {
+                    cout << "Limite de tempo em segundos: ";
+                    cin >> config.time_limit;
+                }
+                config.seed = nova_semente();
+                auto start = chrono::high_resolution_clock::now();
+                TabuStats stats;
+                Solution solution = graph.busca_tabu(p, config, &stats);
+                chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - start;
+                Reporter(graph.csr(), Verbosity::SUMMARY).report(solution);
+                cout << "Movimentos: " << stats.iterations << " (" << stats.aspirations << " por aspiração), perturbações: " << stats.kicks << endl;
+                cout << "Tempo de execução (Busca tabu): " << elapsed.count() << " segundos\n";
+                break;
+            }
             case 0: {
                 cout << "Saindo...\n";
                 break;